@@ -5,6 +5,9 @@
 #include "Produit.h"
 #include <iostream>
 #include "BoiteAuLettres.h"
+#include "GenerateurAleatoire.h"
+#include "TableProduits.h"
+#include "Negociation.h"
 #include <memory>
 
 using namespace std ;
@@ -13,11 +16,13 @@ class Acheteur
 {
 private:
     int acheteur_id ;
-    shared_ptr<Produit> produit ; // pour l'instant inutil
+    PoigneeProduit produit ; //Voiture recherchee, puis voiture achetee
     bool enNegociation;
     int strategie;
     float prix_cible;
+    float prix_accord; //Prix de la voiture achetee, le produit du vendeur n'est pas modifie
     vector<shared_ptr<BoiteAuLettres>> boite_au_lettres;
+    GenerateurAleatoire aleatoire; // Flux propre a l'acheteur, derive de la graine de session
 
 
 public:
@@ -29,32 +34,34 @@ public:
     //Setter
     void insertBaL(int placement, shared_ptr<BoiteAuLettres> bal);
     void setProduitVoit(string m,string b,float prx);
-    void setProd(shared_ptr<Produit> v);
+    void setProd(PoigneeProduit v);
     void setStrat(int s);
     void setPrix(float prx);
 
     // Getters
     float getPrix();
+    float getPrixAccord() const;
     int getId() const;
     int getStrat()const;
-    shared_ptr<Produit> getProduit() const ;
+    Produit* getProduit() const ;
+    PoigneeProduit getPoigneeProduit() const;
     shared_ptr<BoiteAuLettres> getBoiteAuLettres(int id_Vendeur) const;
     vector<shared_ptr<BoiteAuLettres>> getBoiteAuLettresvec() const;
     bool acceptCheck(float& dernierOffre,float& vendeur_offre);
 
     //Creer des messages
-    shared_ptr<Message> creerMessage(  string obj, float offr, string mess, int id_recep);
+    Message creerMessage(Verbe obj, float offr, int id_recep);
 
     //methodes por négociations
-    void negocier(int thread_id, int num_threads, vector<shared_ptr<BoiteAuLettres>> &bal_finale);
+    Negociation negocier(int thread_id, int num_threads, vector<shared_ptr<BoiteAuLettres>> &bal_finale); //coroutine, voir Negociation
 
     //Strategies
 
-    shared_ptr<Message> neg_offre(shared_ptr<Message> dernierMessage,float &prix_cible, float &vendeur_offre_avant,float &vendeur_offre,float &acheteur_offre_avant, float &pasapas ,int &nbr_tours,int &nombre_de_tours_max, int& tours_obligation_acheter);
+    Message neg_offre(const Message& dernierMessage,float &prix_cible, float &vendeur_offre_avant,float &vendeur_offre,float &acheteur_offre_avant, float &pasapas ,int &nbr_tours,int &nombre_de_tours_max, int& tours_obligation_acheter);
 
-    shared_ptr<Message> neg_accept(shared_ptr<Message> dernierMessage);
+    Message neg_accept(const Message& dernierMessage);
 
-    shared_ptr<Message> neg_breakdown(shared_ptr<Message> dernierMessage);
+    Message neg_breakdown(const Message& dernierMessage);
 };
 
 
@@ -0,0 +1,59 @@
+#ifndef ANALYSEUR_CSV_H
+#define ANALYSEUR_CSV_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+//Une ligne du schema des voitures, les textes pointent dans le contenu analyse
+struct LigneCSV {
+    bool valide = false;        //Faux si un champ manque ou n'est pas un nombre
+    string_view modele;
+    int annee = 0;
+    float prix = 0.0f;
+    string_view boite;
+    int kilometres = 0;
+    string_view essence;
+    int taxe = 0;
+    float mpg = 0.0f;
+    float taille_engin = 0.0f;
+};
+
+//Analyseur des fichiers CSV de voitures (model,year,price,transmission,mileage,fuelType,tax,mpg,engineSize)
+//Les separateurs sont cherches 64 octets a la fois avec SSE2/AVX2, les nombres sont lus sur place
+class AnalyseurCSV
+{
+public:
+    enum Champ { MODELE, ANNEE, PRIX, BOITE, KILOMETRES, ESSENCE, TAXE, MPG, TAILLE_ENGIN, NBR_CHAMPS };
+
+private:
+    static const int MAX_COLONNES = 32;
+
+    const char* debut;
+    const char* fin;
+    const char* position;       //Debut du prochain champ
+    const char* bloc;           //Bloc de 64 octets en cours d'examen
+    uint64_t masque;            //Separateurs du bloc pas encore consommes
+    int champs[MAX_COLONNES];   //Colonne du fichier -> champ du schema, -1 si ignoree
+    int nbr_colonnes;
+
+    const char* prochainSeparateur();
+    bool lireLigneBrute(string_view* colonnes, int& nbr);
+
+public:
+    AnalyseurCSV(string_view contenu);
+
+    bool lireEnTete();                  //Associe les colonnes de l'en-tete aux champs du schema
+    void utiliserEnTete(const AnalyseurCSV& autre);    //Pour analyser un morceau de fichier sans son en-tete
+    bool suivante(LigneCSV& ligne);     //Faux a la fin du contenu
+    size_t getPosition() const;         //Octets deja consommes
+
+    static const char* getJeuInstructions();    //"AVX2", "SSE2" ou "scalaire"
+    static void forcerScalaire(bool scalaire);  //Pour comparer avec les versions SIMD (tests)
+    static int trouverChamp(string_view nom);   //-1 si la colonne ne fait pas partie du schema
+};
+
+#endif
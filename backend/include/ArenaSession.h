@@ -0,0 +1,91 @@
+#ifndef ARENA_SESSION_H
+#define ARENA_SESSION_H
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+#include <string>
+#include <new>
+
+using namespace std;
+
+//Arene monotone d'une session : les objets sont pris dans quelques gros blocs, rendus tous ensemble
+//quand l'arene est detruite (dernier objet detruit, l'allocateur garde l'arene en vie)
+class ArenaSession
+{
+public:
+    struct Statistiques {
+        size_t objets = 0;              //Allocations depuis la creation
+        size_t objets_vivants = 0;
+        size_t pic_objets_vivants = 0;
+        size_t octets = 0;              //Octets demandes depuis la creation
+        size_t octets_vivants = 0;
+        size_t pic_octets_vivants = 0;
+        size_t octets_reserves = 0;     //Taille totale des blocs
+        size_t blocs = 0;
+    };
+
+    static constexpr size_t TAILLE_BLOC = 64 * 1024;
+
+private:
+    const size_t taille_bloc;
+    vector<char*> blocs;
+    char* courant;
+    char* fin;
+    Statistiques stats;
+    mutable mutex mtx;                  //Vendeurs et acheteurs allouent depuis leurs threads
+
+    char* nouveauBloc(size_t taille);
+
+public:
+    explicit ArenaSession(size_t taille_bloc = TAILLE_BLOC);
+    ~ArenaSession();
+    ArenaSession(const ArenaSession&) = delete;
+    ArenaSession& operator=(const ArenaSession&) = delete;
+
+    void* allouer(size_t taille, size_t alignement);
+    void rendre(size_t taille);         //Compte seulement, la memoire revient a la destruction de l'arene
+    Statistiques getStatistiques() const;
+    void afficherStatistiques(const string& nom) const;
+};
+
+//Allocateur pour allocate_shared : le bloc de controle et l'objet sont pris dans l'arene
+//Sans arene (nullptr), allocation ordinaire sur le tas
+template<class T>
+class AllocateurArena
+{
+private:
+    shared_ptr<ArenaSession> arena;
+
+    template<class U> friend class AllocateurArena;
+
+public:
+    typedef T value_type;
+
+    explicit AllocateurArena(shared_ptr<ArenaSession> a) : arena(move(a)) {}
+    template<class U>
+    AllocateurArena(const AllocateurArena<U>& autre) : arena(autre.arena) {}
+
+    T* allocate(size_t n) {
+        if (arena == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena->allouer(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (arena == nullptr) {
+            ::operator delete(p);
+            return;
+        }
+        arena->rendre(n * sizeof(T));
+    }
+
+    template<class U>
+    bool operator==(const AllocateurArena<U>& autre) const { return arena == autre.arena; }
+    template<class U>
+    bool operator!=(const AllocateurArena<U>& autre) const { return arena != autre.arena; }
+};
+
+#endif
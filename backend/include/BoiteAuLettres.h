@@ -2,41 +2,81 @@
 #define _BAL_H
 
 #include <vector>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
-#include <mutex>
 #include "Message.h"
 #include "Protocol.h"
 #include <memory>
 
 using namespace std ;
 
+//Boite d'une paire acheteur/vendeur : un anneau par sens, chacun ecrit par un seul thread, lu sans verrou
+//L'historique (vue Chats, getMessage) est optionnel, sans lui seuls les derniers messages de chaque sens restent
 class BoiteAuLettres
 {
+    public:
+        enum class Emetteur : uint8_t { ACHETEUR = 0, VENDEUR = 1 };
+
+        static constexpr uint32_t CAPACITE_ANNEAU = 16;     //Puissance de 2
+
     private:
-        vector<shared_ptr<Message>> boiteAuLettres; //Vecteur de Messages
+        //Fenetre des CAPACITE_ANNEAU derniers messages d'un sens, pas une file : rien n'est consomme a la lecture
+        //et il n'y a pas d'indice de lecture, le message le plus ancien est ecrase. ecrits compte les messages
+        //laisses depuis la creation, chaque lecteur garde le nombre qu'il a deja traite (Vendeur::Conversation)
+        //Un seul ecrivain (l'emetteur), des lecteurs quelconques. L'ecrivain attend la reponse de l'autre avant
+        //d'ecrire a nouveau : il n'a jamais CAPACITE_ANNEAU messages d'avance sur une lecture en cours
+        struct Anneau {
+            array<Message, CAPACITE_ANNEAU> messages;
+            array<uint32_t, CAPACITE_ANNEAU> sequences;     //Rang du message dans la discussion
+            atomic<uint32_t> ecrits{0};
+        };
+
+        static constexpr uint32_t TAILLE_SEGMENT = 64;
+        static constexpr uint32_t NBR_SEGMENTS_MAX = 1024;
+
+        struct Entree {
+            Message message;
+            atomic<bool> publie{false};
+        };
+        typedef array<Entree, TAILLE_SEGMENT> Segment;
+        typedef array<atomic<Segment*>, NBR_SEGMENTS_MAX> Historique;
+
+        array<Anneau, 2> anneaux;
+        atomic<uint32_t> sequence; //Rang du prochain message, tous sens confondus
+        atomic<uint32_t> relances; //Reveils de l'acheteur sans message, voir relancer
+        unique_ptr<Historique> historique; //Segments jamais deplaces, nullptr sans historique
         shared_ptr<Protocol> protocol;
-        mutable std::mutex mtx;
+
+        void archiver(uint32_t rang, const Message& m);
 
     public:
-        BoiteAuLettres(shared_ptr<Protocol> pro);
+        BoiteAuLettres(shared_ptr<Protocol> pro, bool avec_historique = true);
         ~BoiteAuLettres();
+        BoiteAuLettres(const BoiteAuLettres&) = delete;
+        BoiteAuLettres& operator=(const BoiteAuLettres&) = delete;
 
 
         //Messages controlleur
-        int laisserMessage(shared_ptr<Message> m); //Methode que vendeur et acheteur utilisent pour laisser un message
-        shared_ptr<Message> dernierMessage(); //retourne le dernier message
+        int laisserMessage(Message m, Emetteur emetteur); //Methode que vendeur et acheteur utilisent pour laisser un message
+        Message dernierMessage() const; //retourne le dernier message (vide si la boite est vide)
+        void relancer(); //L'acheteur reveille le vendeur sans laisser de message, avant de le signaler
 
         void afficherDiscussion();  //Affiche toutes les messages au terminal
 
         //Getters
-        bool estVide();
-        int getSize();
-        shared_ptr<Message> getMessage(int i);
+        bool estVide() const;
+        int getSize() const;
+        int getNbrMessages(Emetteur emetteur) const; //Messages laisses par un cote
+        int getNbrRelances() const;
+        Message getMessage(int i) const; //Message vide s'il n'est plus garde
         shared_ptr<Protocol> getProtocol() const;
-        std::vector<std::shared_ptr<Message>> getBoiteAuLettres() const;
+        std::vector<Message> getBoiteAuLettres() const;
+        bool aHistorique() const { return historique != nullptr; }
 
         //Setters
         void setProtocol(shared_ptr<Protocol> prot);
 };
 
-#endif
\ No newline at end of file
+#endif
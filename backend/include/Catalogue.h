@@ -0,0 +1,69 @@
+#ifndef CATALOGUE_H
+#define CATALOGUE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <cstdint>
+#include "CatalogueColonnes.h"
+#include "ProjectionFichier.h"
+
+using namespace std;
+
+class Catalogue
+{
+private:
+    struct FichierProjete {
+        string chemin;
+        string marque;
+        ProjectionFichier projection;
+        vector<uint32_t> lignes;        // Offset du debut de chaque ligne (0 = en-tete)
+    };
+
+    vector<FichierProjete> fichiers;    // Un fichier par marque, dans l'ordre des categories
+    CatalogueColonnes colonnes;         // Toutes les lignes decodees, en colonnes
+    bool charge;
+    bool depuis_instantane;             // Colonnes lues depuis l'instantane binaire
+    mutable std::mutex mtx;
+    atomic<int> progression;            // Pourcentage du chargement en cours
+    atomic<bool> termine;               // Chargement termine, reussi ou non
+    future<bool> prechargement;         // Chargement lance en arriere-plan par precharger
+
+    Catalogue();
+    bool projeter(FichierProjete& f);
+    void chargerColonnes(const string& dossier);
+    string_view ligneFichier(int cat, int numero) const;
+
+public:
+    ~Catalogue();
+    Catalogue(const Catalogue&) = delete;
+    Catalogue& operator=(const Catalogue&) = delete;
+
+    static Catalogue& getInstance();
+    static const string DOSSIER_DATA_DEFAUT;
+
+    //Chargement
+    bool charger(const string& dossier = DOSSIER_DATA_DEFAUT); //Projette les fichiers et construit l'index des lignes
+    void precharger(const string& dossier = DOSSIER_DATA_DEFAUT); //Lance charger dans un thread, ne bloque pas
+    bool estCharge() const;
+    bool estTermine() const;                               //Ne bloque pas, contrairement a estCharge
+    int getProgression() const;                            //De 0 a 100
+    bool estDepuisInstantane() const;
+
+    //Getters
+    int getNbrMarques() const;
+    string getMarque(int cat) const;
+    string getChemin(int cat) const;
+    int getNbrLignes(int cat) const;                       //Nombre de lignes de donnees (sans l'en-tete)
+    string_view getLigne(int cat, int ligne) const;        //Ligne de donnees en O(1), sans le '\r' final
+    vector<string> getChamps(int cat, int ligne) const;    //Ligne decoupee sur ','
+    int trouverCategorie(const string& chemin) const;      //-1 si le fichier n'est pas dans le catalogue
+    vector<string> getChampsFichier(int cat, int numero) const; //Numero de ligne du fichier (0 = en-tete)
+    string_view getContenu(int cat) const;                 //Fichier complet, en-tete compris
+    const CatalogueColonnes& getColonnes() const;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef CATALOGUE_COLONNES_H
+#define CATALOGUE_COLONNES_H
+
+#include <vector>
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include "Dictionnaire.h"
+#include "Voiture.h"
+
+using namespace std;
+
+class Catalogue;
+class AnalyseurCSV;
+
+//Critere de recherche traduit en codes, pour comparer directement les colonnes
+struct CritereColonnes {
+    bool impossible = false;    //Une valeur demandee n'existe pas dans le catalogue
+    int marque = -1;            //-1 = toutes
+    int modele = -1;
+    int boite = -1;
+    int essence = -1;
+    int annee_min = 0;
+    int kilometres_max = 0;     //0 = pas de limite
+    float mpg_min = 0.0f;
+    float taille_engin_min = 0.0f;
+};
+
+class CatalogueColonnes
+{
+    friend class InstantaneCatalogue;
+
+private:
+    //Colonnes numeriques
+    vector<int32_t> annees;
+    vector<float> prix;
+    vector<int32_t> kilometres;
+    vector<int32_t> taxes;
+    vector<float> mpgs;
+    vector<float> tailles_engin;
+
+    //Colonnes encodees par dictionnaire
+    vector<CodeDico> marques;
+    vector<CodeDico> modeles;
+    vector<CodeDico> boites;
+    vector<CodeDico> essences;
+
+    Dictionnaire dico_marques;
+    Dictionnaire dico_modeles;
+    Dictionnaire dico_boites;
+    Dictionnaire dico_essences;
+
+    vector<uint32_t> debut_marques;     //Premiere ligne de chaque marque, plus une sentinelle
+
+    struct Morceau;     //Morceau de fichier decode independamment des autres
+
+    static const size_t TAILLE_MORCEAU = 256 * 1024;   //Octets, ford.csv est decoupe en 4 morceaux
+
+    static void decouper(int cat, string_view donnees, const AnalyseurCSV* en_tete, vector<Morceau>& morceaux);
+    static void analyser(Morceau& m);
+    void fusionner(const Morceau& m, CodeDico code_marque);
+
+public:
+    CatalogueColonnes();
+
+    //Decode les fichiers CSV, 0 = un thread par coeur. La progression est appelee depuis les threads de decodage
+    void construire(const Catalogue& catalogue, unsigned nbr_threads = 0,
+                    const function<void(size_t faits, size_t total)>& progression = nullptr);
+    void vider();
+    void preparerChaines();     //Interne les valeurs des dictionnaires, apres construction ou lecture
+
+    //Getters
+    size_t getNbrLignes() const;
+    int getNbrMarques() const;
+    uint32_t getDebutMarque(int cat) const;
+    uint32_t getNbrLignesMarque(int cat) const;
+
+    const vector<int32_t>& getAnnees() const { return annees; }
+    const vector<float>& getPrix() const { return prix; }
+    const vector<int32_t>& getKilometres() const { return kilometres; }
+    const vector<int32_t>& getTaxes() const { return taxes; }
+    const vector<float>& getMPGs() const { return mpgs; }
+    const vector<float>& getTaillesEngin() const { return tailles_engin; }
+    const vector<CodeDico>& getMarques() const { return marques; }
+    const vector<CodeDico>& getModeles() const { return modeles; }
+    const vector<CodeDico>& getBoites() const { return boites; }
+    const vector<CodeDico>& getEssences() const { return essences; }
+
+    const Dictionnaire& getDicoMarques() const { return dico_marques; }
+    const Dictionnaire& getDicoModeles() const { return dico_modeles; }
+    const Dictionnaire& getDicoBoites() const { return dico_boites; }
+    const Dictionnaire& getDicoEssences() const { return dico_essences; }
+
+    //Recherche
+    CritereColonnes traduireCritere(const Voiture& v) const;
+    bool correspond(uint32_t ligne, const CritereColonnes& c) const;
+
+    //Construit une voiture a partir d'une ligne
+    Voiture creerVoiture(uint32_t ligne, int id) const;
+};
+
+#endif
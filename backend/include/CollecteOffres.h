@@ -0,0 +1,37 @@
+#ifndef COLLECTE_OFFRES_H
+#define COLLECTE_OFFRES_H
+
+#include <vector>
+#include <mutex>
+#include "Evenement.h"
+
+using namespace std;
+
+//Reponses a la recherche d'un acheteur, envoyee a tous ses candidats en meme temps (compte a rebours)
+//La derniere reponse, le seuil d'offres ou le delai ferme la collecte et reveille l'acheteur une seule fois
+//Une reponse arrivee apres la fermeture est refusee : l'acheteur ne la lira pas
+class CollecteOffres
+{
+private:
+    mutex mtx;
+    int attendues;              //Reponses pas encore arrivees
+    int offres;                 //Offres (pas de break-down) parmi les reponses arrivees
+    int seuil;                  //Offres suffisantes, 0 = toutes les reponses
+    bool ouverte;
+    vector<int> repondants;     //Vendeurs arrives avant la fermeture
+    Evenement* reveil;          //Evenement de l'acheteur
+
+    void fermer();              //mtx doit etre pris
+
+public:
+    CollecteOffres();
+    CollecteOffres(const CollecteOffres&) = delete;
+    CollecteOffres& operator=(const CollecteOffres&) = delete;
+
+    void ouvrir(int nbr_reponses, int nbr_offres_suffisantes, Evenement* evenement); //Avant d'envoyer la recherche
+    bool deposer(int id_vendeur, bool offre); //false si la collecte est deja fermee
+    void expirer();             //Delai ecoule : ferme la collecte si elle est encore ouverte
+    vector<int> getRepondants();    //Par indice croissant, a lire une fois l'acheteur reveille
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef DICTIONNAIRE_H
+#define DICTIONNAIRE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "TableChaines.h"
+
+using namespace std;
+
+typedef uint16_t CodeDico;
+
+class Dictionnaire
+{
+private:
+    vector<string> valeurs;                     //Chaine de chaque code
+    unordered_map<string, CodeDico> codes;      //Code de chaque chaine
+    vector<IdChaine> ids_chaines;               //Identifiant global de chaque code, rempli par internerValeurs
+    unordered_map<IdChaine, CodeDico> codes_ids;
+
+public:
+    Dictionnaire();
+
+    CodeDico encoder(string_view valeur);       //Ajoute la valeur si elle est absente
+    int chercher(const string& valeur) const;   //-1 si la valeur est absente
+    const string& decoder(CodeDico code) const;
+
+    //Correspondance avec la table globale des chaines
+    void internerValeurs();                     //A appeler une fois le dictionnaire complet
+    IdChaine getIdChaine(CodeDico code) const;
+    int chercherId(IdChaine id) const;          //-1 si la valeur est absente
+
+    size_t getTaille() const;
+    void vider();
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef ECHELLE_PRIX_H
+#define ECHELLE_PRIX_H
+
+#include <atomic>
+
+using namespace std;
+
+//Multiplicateur des prix d'un vendeur, cumule depuis sa creation
+//Les produits gardent la valeur du facteur au moment ou leur prix a ete fixe et l'appliquent a la lecture
+class EchellePrix
+{
+private:
+    atomic<double> facteur;
+
+public:
+    EchellePrix();
+
+    double getFacteur() const { return facteur.load(memory_order_relaxed); }
+    void multiplier(double f);      //Un seul ecrivain : le thread du vendeur
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef EVENEMENT_H
+#define EVENEMENT_H
+
+#include <mutex>
+#include <condition_variable>
+#include <coroutine>
+
+using namespace std;
+
+//Reveil d'un agent (acheteur ou vendeur) : chacun a le sien, il n'y a plus de verrou commun a tout le marche
+//L'agent est une coroutine (Negociation) : co_await attendre() la suspend, signaler la reprend sur l'Ordonnanceur
+//Les signaux se comptent : deux messages arrives avant la reprise de l'agent le reveillent deux fois
+//En mode Negociation::Execution::THREADS, co_await bloque le thread de l'agent sur cv au lieu de le suspendre
+class Evenement
+{
+public:
+    struct Attente {
+        Evenement& evenement;
+        bool await_ready() { return evenement.avantAttente(); }
+        bool await_suspend(coroutine_handle<> h) { return evenement.suspendre(h); }
+        void await_resume() {}
+    };
+
+private:
+    mutex mtx;
+    condition_variable cv;      //Mode THREADS seulement
+    int signaux;                //Signaux recus et pas encore consommes
+    coroutine_handle<> attente; //Agent suspendu sur cet evenement, nul sinon
+
+    bool avantAttente();        //true s'il reste un signal ; en mode THREADS, bloque jusqu'au prochain
+    bool suspendre(coroutine_handle<> h); //false si un signal est arrive entre-temps
+
+public:
+    Evenement();
+    Evenement(const Evenement&) = delete;
+    Evenement& operator=(const Evenement&) = delete;
+
+    Attente attendre() { return Attente{*this}; } //co_await : continue s'il reste un signal, sinon suspend l'agent
+    void signaler();        //Ajoute un signal et reprend l'agent s'il etait suspendu
+    void consommer();       //Retire le signal traite, a appeler avant de signaler l'autre agent
+    bool estPret();
+};
+
+#endif
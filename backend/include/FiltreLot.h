@@ -0,0 +1,52 @@
+#ifndef FILTRE_LOT_H
+#define FILTRE_LOT_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include "TableChaines.h"
+
+using namespace std;
+
+//Une recherche traduite en bornes, VIDE = toutes les valeurs pour les chaines
+struct RequeteFiltre {
+    int32_t annee_min = 0;
+    int32_t kilometres_max = numeric_limits<int32_t>::max();
+    float mpg_min = -numeric_limits<float>::infinity();
+    float taille_engin_min = -numeric_limits<float>::infinity();
+    IdChaine marque = TableChaines::VIDE;
+    IdChaine modele = TableChaines::VIDE;
+    IdChaine boite = TableChaines::VIDE;
+    IdChaine essence = TableChaines::VIDE;
+    IdChaine categorie = TableChaines::VIDE;
+};
+
+//Inventaire d'un vendeur en colonnes, toutes de taille nbr_lignes
+struct InventaireColonnes {
+    size_t nbr_lignes = 0;
+    const int32_t* annees = nullptr;
+    const int32_t* kilometres = nullptr;
+    const float* mpgs = nullptr;
+    const float* tailles_engin = nullptr;
+    const float* prix = nullptr;
+    const IdChaine* marques = nullptr;
+    const IdChaine* modeles = nullptr;
+    const IdChaine* boites = nullptr;
+    const IdChaine* essences = nullptr;
+    const IdChaine* categories = nullptr;
+};
+
+//Evaluation d'un lot de recherches sur un inventaire : ligne la moins chere de chaque recherche
+//Comparaisons AVX2 sur 8 lignes a la fois si le processeur le permet, boucle simple sinon
+class FiltreLot
+{
+public:
+    //lignes[i] = ligne la moins chere pour requetes[i], -1 si aucune. A prix egal, la premiere ligne
+    static void moinsChers(const InventaireColonnes& inventaire, const vector<RequeteFiltre>& requetes,
+                           vector<int32_t>& lignes);
+    static const char* getJeuInstructions();    //"AVX2" ou "scalaire"
+    static void forcerScalaire(bool scalaire);  //Pour comparer avec la version AVX2 (tests)
+};
+
+#endif
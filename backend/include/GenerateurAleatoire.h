@@ -0,0 +1,32 @@
+#ifndef GENERATEUR_ALEATOIRE_H
+#define GENERATEUR_ALEATOIRE_H
+
+#include <cstdint>
+#include <atomic>
+
+using namespace std;
+
+//Generateur xoshiro256** : chaque agent possede son propre flux, derive de la graine de session
+class GenerateurAleatoire
+{
+private:
+    uint64_t etat[4];
+
+    static atomic<uint64_t> graine_session;     //0 tant qu'aucune graine n'a ete choisie
+
+public:
+    //Familles de flux, pour que vendeur 0 et acheteur 0 n'aient pas le meme flux
+    enum Famille { FLUX_INITIALISATION = 1, FLUX_VENDEUR = 2, FLUX_ACHETEUR = 3, FLUX_SANS_INTERFACE = 4 };
+
+    explicit GenerateurAleatoire(uint64_t graine);
+
+    uint64_t suivant();
+    int entre(int min, int max);    //Entier uniforme entre les deux bornes incluses
+
+    //Graine de session
+    static void setGraineSession(uint64_t graine);
+    static uint64_t getGraineSession();     //Tiree au hasard au premier appel si aucune n'a ete choisie
+    static GenerateurAleatoire flux(Famille famille, uint64_t indice);
+};
+
+#endif
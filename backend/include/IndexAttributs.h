@@ -0,0 +1,73 @@
+#ifndef INDEX_ATTRIBUTS_H
+#define INDEX_ATTRIBUTS_H
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "Produit.h"
+#include "TableChaines.h"
+#include "FiltreLot.h"
+
+using namespace std;
+
+class Voiture;
+
+//Index multi-attributs des voitures d'un inventaire, pour les recherches par intervalles
+//(annee >=, kilometres <=, mpg >=, taille du moteur >=) avec ou sans marque
+class IndexAttributs
+{
+private:
+    //Lignes de l'index, dans l'ordre de l'inventaire du vendeur, en colonnes
+    vector<shared_ptr<Produit>> produits;
+    vector<int32_t> annees;
+    vector<int32_t> kilometres;
+    vector<float> mpgs;
+    vector<float> tailles_engin;
+    vector<IdChaine> marques;
+    vector<IdChaine> modeles;
+    vector<IdChaine> boites;
+    vector<IdChaine> essences;
+    vector<IdChaine> categories;
+    vector<float> prix_lot;     //Prix releves au debut de chaque lot de recherches
+    unordered_map<const Produit*, uint32_t> ligne_de;   //Ligne de chaque produit vivant, pour les retraits
+    size_t nbr_mortes;          //Lignes retirees (produit nul), sautees jusqu'a la prochaine reconstruction
+
+    //Les lignes mortes sont compactees quand elles depassent 1 ligne sur PART_MORTES
+    static constexpr size_t PART_MORTES = 4;
+
+    //Lignes d'un groupe triees selon chaque attribut
+    struct Groupe {
+        vector<uint32_t> lignes;
+        vector<uint32_t> par_annee;
+        vector<uint32_t> par_kilometres;
+        vector<uint32_t> par_mpg;
+        vector<uint32_t> par_taille;
+    };
+
+    Groupe tous;
+    unordered_map<IdChaine, Groupe> par_marque;
+    bool a_jour;    //Les groupes sont reconstruits a la premiere recherche apres un ajout
+
+    void compacter();
+    void construire();
+    void trierGroupe(Groupe& g) const;
+    bool correspond(uint32_t ligne, const Voiture& critere) const;
+    static RequeteFiltre traduire(const Voiture& critere);
+
+public:
+    IndexAttributs();
+
+    void ajouter(const shared_ptr<Produit>& p);
+    void retirer(const Produit* p);
+    void vider();
+
+    //Produit le moins cher qui satisfait le critere, nullptr si aucun
+    //A egalite de prix, la premiere ligne, dans l'ordre d'ajout
+    shared_ptr<Produit> moinsCher(const Voiture& critere);
+    //Meme resultat pour un lot de recherches, evaluees ensemble par FiltreLot
+    void moinsChersLot(const vector<const Voiture*>& criteres, vector<shared_ptr<Produit>>& resultats);
+    size_t getTaille() const;
+};
+
+#endif
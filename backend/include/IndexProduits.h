@@ -0,0 +1,50 @@
+#ifndef INDEX_PRODUITS_H
+#define INDEX_PRODUITS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "Produit.h"
+#include "TableChaines.h"
+#include "IndexAttributs.h"
+
+using namespace std;
+
+//Index des produits d'un vendeur par (marque, modele), chaque seau etant trie par prix croissant
+class IndexProduits
+{
+public:
+    struct Entree {
+        shared_ptr<Produit> produit;
+        int ligne;                  //Ligne du catalogue en colonnes, -1 si hors catalogue
+    };
+
+private:
+    unordered_map<uint64_t, vector<Entree>> seaux;  //Cle = identifiants (marque, modele) dans TableChaines
+    unordered_map<int, shared_ptr<Produit>> par_id;    //Identifiants d'annonce, uniques
+    IndexAttributs attributs;                       //Recherches par intervalles, sans modele precis
+
+    static void inserer(vector<Entree>& seau, const Entree& e);
+    static void enlever(vector<Entree>& seau, const Produit* p);
+    static const vector<Entree>& trier(vector<Entree>& seau);
+
+public:
+    static uint64_t cle(IdChaine marque, IdChaine modele);
+
+    void ajouter(const shared_ptr<Produit>& p, int ligne);
+    void retirer(const Produit* p);
+    void vider();
+    void reordonner();      //Apres une modification des prix
+
+    shared_ptr<Produit> chercherId(int id) const;
+    //Seaux tries par prix croissant, nullptr si aucun produit
+    const vector<Entree>* seau(IdChaine marque, IdChaine modele);
+    //Produit le moins cher pour une recherche sans marque ou sans modele
+    shared_ptr<Produit> chercherAttributs(const Voiture& critere);
+    //Produit le moins cher de chaque recherche d'un lot, evaluees ensemble
+    void chercherLot(const vector<const Voiture*>& criteres, vector<shared_ptr<Produit>>& resultats);
+};
+
+#endif
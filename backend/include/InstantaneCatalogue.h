@@ -0,0 +1,40 @@
+#ifndef INSTANTANE_CATALOGUE_H
+#define INSTANTANE_CATALOGUE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "CatalogueColonnes.h"
+
+using namespace std;
+
+//Etat d'un fichier CSV source, pour valider l'instantane
+struct EtatSource {
+    uint64_t taille = 0;
+    int64_t date_modif = 0;
+    uint64_t somme = 0;
+    bool somme_calculee = false;
+    const char* donnees = nullptr;      //Contenu projete, pour calculer la somme si besoin
+
+    uint64_t getSomme();
+};
+
+//Instantane binaire versionne du catalogue en colonnes
+class InstantaneCatalogue
+{
+public:
+    static const uint32_t VERSION;
+    static const string NOM_FICHIER;
+
+    static uint64_t sommeControle(const char* donnees, size_t taille);
+
+    //Ecrit l'instantane (fichier temporaire puis renommage)
+    static bool ecrire(const string& chemin, const CatalogueColonnes& colonnes, vector<EtatSource>& sources);
+
+    //Charge l'instantane s'il est valide pour les sources donnees.
+    //dates_changees indique qu'une date a change sans que le contenu change : l'instantane est a reecrire.
+    static bool lire(const string& chemin, CatalogueColonnes& colonnes, vector<EtatSource>& sources, bool& dates_changees);
+};
+
+#endif
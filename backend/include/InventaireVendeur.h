@@ -0,0 +1,51 @@
+#ifndef INVENTAIRE_VENDEUR_H
+#define INVENTAIRE_VENDEUR_H
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "Produit.h"
+
+using namespace std;
+
+//Inventaire d'un vendeur en "slot map" : ajout et retrait en O(1), cles stables avec generation
+//Les produits restent contigus (parcours, getProduits) : un retrait deplace le dernier produit a sa place
+class InventaireVendeur
+{
+public:
+    struct Cle {
+        uint32_t indice = 0;
+        uint32_t generation = 0;    //0 = aucune cle
+    };
+
+private:
+    struct Emplacement {
+        uint32_t dense = 0;         //Position du produit dans produits
+        uint32_t generation = 1;
+    };
+
+    //Partie dense, dans l'ordre de parcours
+    vector<shared_ptr<Produit>> produits;
+    vector<int> lignes;                         //Ligne du catalogue en colonnes, -1 si hors catalogue
+    vector<uint32_t> emplacement_de;            //Emplacement de chaque position dense
+
+    vector<Emplacement> emplacements;
+    vector<uint32_t> libres;
+    unordered_map<const Produit*, uint32_t> par_produit;
+
+    void retirerEmplacement(uint32_t indice);
+
+public:
+    Cle ajouter(const shared_ptr<Produit>& p, int ligne);
+    bool retirer(Cle cle);                      //false si la cle est perimee
+    bool retirer(const Produit* p);             //false si le produit n'est pas dans l'inventaire
+
+    shared_ptr<Produit> obtenir(Cle cle) const; //nullptr si la cle est perimee
+    Cle getCle(const Produit* p) const;
+    const vector<shared_ptr<Produit>>& getProduits() const { return produits; }
+    const vector<int>& getLignes() const { return lignes; }
+    size_t getTaille() const { return produits.size(); }
+};
+
+#endif
@@ -3,45 +3,62 @@
 
 #include <string>
 #include <iostream>
-#include <memory>
-#include "Message.h"
+#include <cstdint>
+#include <type_traits>
 #include "Produit.h"
 #include "Voiture.h"
+#include "TableProduits.h"
+#include "TableChaines.h"
 
 
 using namespace std ;
 
-class Message
+//Objet d'une lettre ; AUCUN = pas de message (boite vide)
+enum class Verbe : uint8_t { AUCUN, SEARCH, OFFER, ACCEPT, BREAK_DOWN };
+
+const string& verbeVersTexte(Verbe v);     //"search", "offer", "accept", "break-down"
+
+//Lettre de 32 octets copiee par valeur, sans allocation : le texte libre est interne dans TableChaines
+class alignas(32) Message
 {
     private:
-        int id_emmeteur;
-        int id_recepteur;
-        string objet; //Objet de la lettre
-        shared_ptr<Produit> produit;
-        float offre;    //Offre avec la lettre (s'il y a)
-        string message; //Infos supplementaires
+        int32_t id_emmeteur = -1;
+        int32_t id_recepteur = -1;
+        PoigneeProduit produit; //Poignee dans TableProduits, sans compteur de references
+        float offre = 0.0f;    //Offre avec la lettre (s'il y a)
+        IdChaine message = TableChaines::VIDE; //Infos supplementaires
+        uint16_t tour = 0;      //Tour de la discussion, donne par BoiteAuLettres::laisserMessage
+        Verbe objet = Verbe::AUCUN; //Objet de la lettre
 
     public:
-        Message( int id_e,  int id_r, string obj, float offr, string mess,shared_ptr<Produit> prod);
-        ~Message();
+        Message() = default;
+        Message(int id_e, int id_r, Verbe obj, float offr, PoigneeProduit prod, const string& mess = "");
 
         //setters
         void setIdEmmeteur(int emmet);
         void setIdRecep(int recep);
-        void setObjet(string obj);
+        void setObjet(Verbe obj);
         void setOffre(float offr);
-        void setMessage(string mess);
-        void setProduit( shared_ptr<Produit> prod);
+        void setMessage(const string& mess);
+        void setProduit(PoigneeProduit prod);
+        void setTour(uint16_t t) { tour = t; }
 
         //getters
-        int getIdEmmeteur();
-        int getIdRecep();
-        string getObjet();
-        float getOffre();
-        string getMessage();
-        shared_ptr<Produit> getProduit();
+        bool estVide() const { return objet == Verbe::AUCUN; }
+        int getIdEmmeteur() const;
+        int getIdRecep() const;
+        Verbe getObjet() const { return objet; }
+        float getOffre() const;
+        const string& getMessage() const;
+        uint16_t getTour() const { return tour; }
+        Produit* getProduit() const;    //nullptr si le produit a ete libere
+        PoigneeProduit getPoigneeProduit() const;
 
 
-        void afficherMessage(); //Affiche tous les parties du message au terminal
+        void afficherMessage() const; //Affiche tous les parties du message au terminal
 };
-#endif
\ No newline at end of file
+
+static_assert(sizeof(Message) == 32, "Message doit tenir sur 32 octets");
+static_assert(is_trivially_copyable<Message>::value, "Message doit etre copiable octet par octet");
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef NEGOCIATION_H
+#define NEGOCIATION_H
+
+#include <coroutine>
+#include <functional>
+#include <exception>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+//Negociation d'un acheteur ou d'un vendeur ecrite en coroutine C++20
+//Ses variables vivent dans le cadre de la coroutine (quelques centaines d'octets), pas sur la pile d'un thread
+//Creee suspendue ; demarrer l'execute jusqu'a sa premiere attente, puis chaque signal (Evenement) la reprend
+//En mode THREADS, chaque negociation a son thread et s'y bloque sur son Evenement (variable de condition)
+class Negociation
+{
+public:
+    struct promise_type;
+
+    enum class Execution { ORDONNANCEUR, THREADS };
+
+    //Derniere suspension : previent le proprietaire, sans toucher au cadre apres l'appel
+    struct Fin {
+        bool await_ready() noexcept { return false; }
+        void await_suspend(coroutine_handle<promise_type> h) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    struct promise_type {
+        function<void()> fin;   //Appelee sur le thread qui termine la negociation
+
+        Negociation get_return_object() { return Negociation(coroutine_handle<promise_type>::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        Fin final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); } //Comme une exception sortie d'un std::thread
+    };
+
+private:
+    coroutine_handle<promise_type> poignee;
+    thread execution;           //Thread de la negociation en mode THREADS
+
+    static atomic<Execution> mode;
+
+    explicit Negociation(coroutine_handle<promise_type> h) : poignee(h) {}
+
+public:
+    Negociation(Negociation&& autre) noexcept;
+    Negociation& operator=(Negociation&& autre) noexcept;
+    Negociation(const Negociation&) = delete;
+    Negociation& operator=(const Negociation&) = delete;
+    ~Negociation();     //Detruit le cadre : la negociation doit etre terminee ou ne plus etre reprise
+
+    void demarrer(function<void()> fin); //Execute jusqu'a la premiere attente, sur le thread appelant
+    bool estTerminee() const { return poignee && poignee.done(); }
+
+    //A choisir entre deux sessions, jamais pendant une negociation
+    static void setExecution(Execution e);
+    static Execution getExecution();
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ORDONNANCEUR_H
+#define ORDONNANCEUR_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <map>
+#include <chrono>
+
+using namespace std;
+
+//Pool de threads a vol de taches, de la taille du materiel, partage par toutes les negociations
+//Chaque travailleur prend les taches de sa file dans l'ordre des soumissions, puis vole dans les autres files
+//Les taches ne doivent pas bloquer : un agent qui attend se suspend (voir Evenement)
+//Un thread minuteur soumet les taches differees a leur echeance (delais, voir CollecteOffres)
+class Ordonnanceur
+{
+public:
+    typedef function<void()> Tache;
+
+private:
+    struct File {
+        mutex mtx;
+        deque<Tache> taches;
+    };
+
+    vector<unique_ptr<File>> files;             //Une par travailleur
+    vector<thread> travailleurs;
+    atomic<size_t> suivante;                    //File des soumissions venues d'un thread hors du pool
+    atomic<long> en_attente;                    //Taches soumises et pas encore prises
+    mutex mtx_sommeil;
+    condition_variable cv_sommeil;
+    bool arret;
+
+    multimap<chrono::steady_clock::time_point, Tache> echeances;   //Taches differees, par echeance
+    thread minuteur;
+    mutex mtx_minuteur;
+    condition_variable cv_minuteur;
+    bool arret_minuteur;
+
+    static thread_local int indice_courant;     //Travailleur du thread courant, -1 hors du pool
+
+    explicit Ordonnanceur(size_t nbr_travailleurs);
+    ~Ordonnanceur();
+    bool prendre(size_t indice, Tache& tache);
+    void travailler(size_t indice);
+    void minuter();
+
+public:
+    Ordonnanceur(const Ordonnanceur&) = delete;
+    Ordonnanceur& operator=(const Ordonnanceur&) = delete;
+
+    static Ordonnanceur& getInstance();
+
+    void soumettre(Tache tache);
+    void soumettreApres(chrono::milliseconds delai, Tache tache);  //Abandonnee si le pool s'arrete avant
+    size_t getNbrTravailleurs() const { return travailleurs.size(); }
+};
+
+#endif
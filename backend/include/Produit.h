@@ -2,24 +2,44 @@
 #define PRODUIT_H
 #include<string>
 #include<iostream>
+#include<cstdint>
+#include "TableChaines.h"
+#include "TableProduits.h"
+#include "EchellePrix.h"
+#include <memory>
 
 using namespace std;
 
+//Type concret d'un produit, a la place des fonctions virtuelles et de dynamic_cast
+//Une nouvelle categorie de produit = une valeur ici, sa classe derivee et son cas dans Produit::afficherTout
+enum class TypeProduit : uint8_t { PRODUIT, VOITURE };
+
 class Produit{
 
 private:
+    TypeProduit type;
     int id;
     string description;
     float prix;
     float prixMin;
     float prixMax;
-    string categorie;
+    IdChaine categorie; //Chaine internee dans TableChaines
     string image;
+    PoigneeProduit poignee; //Poignee dans TableProduits, donnee par TableProduits::enregistrer
+    shared_ptr<const EchellePrix> echelle; //Multiplicateur du vendeur, applique a la lecture du prix
+    double facteur_ref = 1.0; //Facteur de l'echelle quand prix a ete fixe
+
+protected:
+    //Pour les classes derivees, qui donnent leur type
+    Produit(TypeProduit t, int idx, string descriptionx, float prixx, string categoriex, string imagex)
+    :type(t),id(idx),description(descriptionx),prix(prixx),categorie(TableChaines::getInstance().interner(categoriex)),image(imagex){}
+
+    void afficherCommun() const; //Informations communes a tous les produits
 
 public:
-    virtual ~Produit();
+    ~Produit();
     Produit(int idx, string descriptionx, float prixx, string categoriex, string imagex)
-    :id(idx),description(descriptionx),prix(prixx),categorie(categoriex),image(imagex){} // pour le constructeur
+    :Produit(TypeProduit::PRODUIT, idx, descriptionx, prixx, categoriex, imagex){} // pour le constructeur
 
     //pour les getters
 
@@ -27,10 +47,14 @@ public:
     string getDescription() const;
     float getPrixMin() const;
     float getPrixMax() const;
-    string getCategorie() const;
+    const string& getCategorie() const;
+    IdChaine getIdCategorie() const { return categorie; }
+    TypeProduit getType() const { return type; }
+    bool estVoiture() const { return type == TypeProduit::VOITURE; }
     string getImage() const;
     int getId() const;
     float getPrix() const;
+    PoigneeProduit getPoignee() const { return poignee; }
     //pour les setters
 
     void setDescription(const string & description);
@@ -40,10 +64,14 @@ public:
     void setCategorie(const string& categorie);
     void setImage(const string& image);
     void setId(int idx);
+    static int nouvelIdentifiant(); //Identifiant d'annonce unique pour la session, distinct de la ligne du catalogue
+    void setPoignee(PoigneeProduit p) { poignee = p; }
+    void setEchelle(shared_ptr<const EchellePrix> e); //Le prix actuel est conserve
+    void figerPrix() { setEchelle(nullptr); } //Detache le produit de l'echelle de son vendeur
 
     // les fonctions/methodes
 
-    virtual void afficherTout() const;
+    void afficherTout() const; //Selon le type du produit
    
 };
 #endif
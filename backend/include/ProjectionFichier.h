@@ -0,0 +1,35 @@
+#ifndef PROJECTION_FICHIER_H
+#define PROJECTION_FICHIER_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+//Fichier projete en memoire en lecture seule
+class ProjectionFichier
+{
+private:
+    const char* debut;
+    size_t taille;
+#ifdef _WIN32
+    void* fichier_win;
+    void* projection_win;
+#endif
+
+public:
+    ProjectionFichier();
+    ~ProjectionFichier();
+    ProjectionFichier(const ProjectionFichier&) = delete;
+    ProjectionFichier& operator=(const ProjectionFichier&) = delete;
+    ProjectionFichier(ProjectionFichier&& autre) noexcept;
+    ProjectionFichier& operator=(ProjectionFichier&& autre) noexcept;
+
+    bool ouvrir(const string& chemin);  //Un fichier vide est ouvert avec succes mais sans donnees
+    void fermer();
+
+    const char* getDebut() const { return debut; }
+    size_t getTaille() const { return taille; }
+};
+
+#endif
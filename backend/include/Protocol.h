@@ -9,6 +9,10 @@ private:
     int penalité;
     int neg_meme_temps;
     bool differer;
+    bool acheteurs_simultanes;
+    int offres_suffisantes;     //0 = attendre toutes les reponses a une recherche
+    int delai_recherche;        //En millisecondes, 0 = sans delai
+    int capacite_vendeur;       //Negociations d'un vendeur en meme temps, au moins 1
 
 public:
     // Constructor
@@ -29,6 +33,18 @@ public:
 
     bool isDifferer() const;
     void setDifferer(bool value);
+
+    bool isAcheteursSimultanes() const;
+    void setAcheteursSimultanes(bool value);
+
+    int getOffresSuffisantes() const;
+    void setOffresSuffisantes(int value);
+
+    int getDelaiRecherche() const;
+    void setDelaiRecherche(int value);
+
+    int getCapaciteVendeur() const;
+    void setCapaciteVendeur(int value);
 };
 
 #endif // PROTOCOL_H
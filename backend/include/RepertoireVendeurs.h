@@ -0,0 +1,48 @@
+#ifndef REPERTOIRE_VENDEURS_H
+#define REPERTOIRE_VENDEURS_H
+
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include "TableChaines.h"
+
+using namespace std;
+
+class Vendeur;
+class Voiture;
+
+//Repertoire du marche : vendeurs ayant au moins un produit de chaque (marque, modele)
+//Construit avant chaque negociation et lu sans verrou pendant celle-ci
+class RepertoireVendeurs
+{
+private:
+    int nbr_vendeurs;
+    unordered_map<uint64_t, vector<int>> par_marque_modele;    //Cle = identifiants (marque, modele)
+    unordered_map<IdChaine, vector<int>> par_marque;
+    unordered_map<int, vector<int>> par_id;                     //Identifiant de produit
+    atomic<long> recherches_envoyees;
+    atomic<long> recherches_evitees;
+
+    RepertoireVendeurs();
+
+    static void ajouterVendeur(vector<int>& vendeurs, int v);
+
+public:
+    RepertoireVendeurs(const RepertoireVendeurs&) = delete;
+    RepertoireVendeurs& operator=(const RepertoireVendeurs&) = delete;
+
+    static RepertoireVendeurs& getInstance();
+
+    void construire(const vector<Vendeur>& vendeurs);
+
+    //Vendeurs a contacter pour une recherche, par indice croissant
+    vector<int> candidats(const Voiture& recherche) const;
+
+    //Statistiques depuis la derniere construction
+    void compterRecherche(int envoyees);
+    long getRecherchesEnvoyees() const;
+    long getRecherchesEvitees() const;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef TABLE_CHAINES_H
+#define TABLE_CHAINES_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdint>
+
+using namespace std;
+
+typedef uint32_t IdChaine;  //0 = chaine vide
+
+//Table globale des chaines internees (marques, modeles, boites, carburants)
+//Deux chaines egales ont le meme identifiant, les comparaisons se font donc sur des entiers
+class TableChaines
+{
+private:
+    deque<string> chaines;                          //Adresses stables, les references restent valides
+    unordered_map<string_view, IdChaine> ids;       //Vues sur les chaines de la deque
+    mutable shared_mutex mtx;
+
+    TableChaines();
+
+public:
+    TableChaines(const TableChaines&) = delete;
+    TableChaines& operator=(const TableChaines&) = delete;
+
+    static TableChaines& getInstance();
+    static constexpr IdChaine VIDE = 0;
+
+    IdChaine interner(string_view chaine);          //Ajoute la chaine si elle est absente
+    const string& getChaine(IdChaine id) const;     //Reference valide jusqu'a la fin du programme
+    size_t getTaille() const;
+};
+
+#endif
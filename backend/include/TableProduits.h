@@ -0,0 +1,66 @@
+#ifndef TABLE_PRODUITS_H
+#define TABLE_PRODUITS_H
+
+#include <memory>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+class Produit;
+
+//Reference sur 8 octets a un produit de TableProduits, sans compteur de references
+//generation 0 = aucun produit ; une poignee dont l'emplacement a ete libere ne donne plus rien
+struct PoigneeProduit {
+    uint32_t indice = 0;
+    uint32_t generation = 0;
+
+    bool estNulle() const { return generation == 0; }
+    bool operator==(const PoigneeProduit& autre) const { return indice == autre.indice && generation == autre.generation; }
+    bool operator!=(const PoigneeProduit& autre) const { return !(*this == autre); }
+};
+
+//Table centrale des produits : messages, acheteurs, garage et panier ne gardent qu'une poignee
+//La table garde le seul shared_ptr, un emplacement libere change de generation avant d'etre reutilise
+class TableProduits
+{
+private:
+    static constexpr uint32_t TAILLE_BLOC = 1024;
+    static constexpr uint32_t NBR_BLOCS_MAX = 4096;
+
+    struct Emplacement {
+        shared_ptr<Produit> produit;
+        Produit* brut = nullptr;                //Lu par obtenir, sans toucher au compteur
+        atomic<uint32_t> generation{1};
+    };
+    typedef array<Emplacement, TAILLE_BLOC> Bloc;
+
+    //Les blocs ne bougent jamais : obtenir lit sans verrou pendant qu'un autre thread enregistre
+    array<atomic<Bloc*>, NBR_BLOCS_MAX> blocs;
+    atomic<uint32_t> nbr_emplacements;
+    vector<uint32_t> libres;
+    size_t nbr_vivants;
+    mutable mutex mtx;                          //Enregistrement et liberation
+
+    TableProduits();
+    ~TableProduits();
+    Emplacement* emplacement(uint32_t indice) const;
+
+public:
+    TableProduits(const TableProduits&) = delete;
+    TableProduits& operator=(const TableProduits&) = delete;
+
+    static TableProduits& getInstance();
+
+    PoigneeProduit enregistrer(const shared_ptr<Produit>& p);
+    void liberer(PoigneeProduit poignee);       //Sans effet sur une poignee nulle ou perimee
+    Produit* obtenir(PoigneeProduit poignee) const; //nullptr si la poignee est nulle ou perimee
+    shared_ptr<Produit> partager(PoigneeProduit poignee) const; //Pour garder le produit hors de la table
+
+    size_t getTaille() const;                   //Produits enregistres et pas encore liberes
+};
+
+#endif
@@ -1,19 +1,20 @@
 #ifndef THREADS_VAR_H
 #define THREADS_VAR_H
 
-#include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <vector>
+#include <memory>
+#include "Evenement.h"
+#include "CollecteOffres.h"
 
 extern int num_childs;
 
-extern std::mutex mtx;
-extern std::vector<std::unique_ptr<std::condition_variable>> child_Achet_cvs;
-extern std::vector<std::unique_ptr<std::condition_variable>> child_Vend_cvs;
-extern std::vector<std::unique_ptr<std::atomic<bool>>> child_ready_flags_Achet;
-extern std::vector<std::unique_ptr<std::atomic<bool>>> child_ready_flags_Vend;
+//Un evenement par agent, plus de mutex global : voir Evenement
+extern std::vector<std::unique_ptr<Evenement>> evenements_Achet;
+extern std::vector<std::unique_ptr<Evenement>> evenements_Vend;
 extern std::unique_ptr<std::atomic<bool>> termination_flag;
+//Reponses a la recherche de chaque acheteur, partagees avec le minuteur du delai : voir CollecteOffres
+extern std::vector<std::shared_ptr<CollecteOffres>> collectes_Achet;
 //extern std::atomic<int> next_child; 
 
 void init_shared_resources_Acheteur(int num_threads);
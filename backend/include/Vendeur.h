@@ -5,36 +5,71 @@
 #include "Voiture.h"
 #include "Produit.h"
 #include "BoiteAuLettres.h"
+#include "GenerateurAleatoire.h"
+#include "IndexProduits.h"
+#include "InventaireVendeur.h"
+#include "ArenaSession.h"
+#include "EchellePrix.h"
+#include "Negociation.h"
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 class Vendeur
 {
+public:
+    //Etat d'une negociation avec un acheteur : une entree par boite, au plus la capacite du protocole actives
+    struct Conversation {
+        bool active = false;
+        int lus = 0;                    //Messages de l'acheteur deja traites
+        int relances_lues = 0;          //Reveils sans message deja traites, voir BoiteAuLettres::relancer
+        PoigneeProduit prod;
+        float acheteur_offre = 0.0f;
+        float acheteur_offre_avant = -1;
+        float vendeur_offre = 0.0f;
+        float prix_minimale = 0.0f;
+        float pas = 0.0f;
+        int nombre_de_tours_max = 0;
+        int recherche_en_lot = -1;      //Message (compte dans lus) auquel repond trouve, -1 = aucun
+        shared_ptr<Produit> trouve;     //Resultat de chercherEnLot, nullptr si rien ne convient
+    };
+
 private:
     float prix_min;
     float prix_max;
-    vector<shared_ptr<Produit>> produits; //Vecteurs des Produits
+    InventaireVendeur inventaire; //Produits et ligne du catalogue en colonnes de chacun, retrait en O(1)
+    vector<PoigneeProduit> vendus; //Produits vendus, hors inventaire, encore designes par les messages
+    IndexProduits index; //Produits par (marque, modele), tries par prix
     int vendeur_id;
     int style_negociacion;
     int tour_karma;
     float prix_cible;
     vector<shared_ptr<Produit>> produits_possibles;
     vector<shared_ptr<BoiteAuLettres>> boite_au_lettres; //Moyen de communication avec le acheteur
+    GenerateurAleatoire aleatoire; //Flux propre au vendeur, derive de la graine de session
+    shared_ptr<ArenaSession> arena_produits; //Voitures de la session des vendeurs (nullptr = tas)
+    shared_ptr<EchellePrix> echelle_prix; //Augmentations de prix, appliquees a la lecture par chaque produit
 public:
     Vendeur(int id,int nombre_acheteur);
     ~Vendeur();
 
     //Vector handlers
     void addVoiture(int id,string description,float prix,string categorie,string image,string br, string mod,int year, string bdv, int km, string essen,float mpg, float te);
+    void addVoitureCatalogue(int id, uint32_t ligne); //ajoute la voiture d'une ligne du catalogue
     void deleteProduits(int id);
-    vector<shared_ptr<Produit>> getProduits(); //retourne le vecteur de produits
-    void augmenterTousPrix(int pourcentage);
+    bool vendre(const Produit* p); //Retire un produit vendu de l'inventaire et des index
+    void libererProduits(); //Libere les poignees de tous les produits, avant d'abandonner le vendeur
+    const vector<shared_ptr<Produit>>& getProduits() const; //retourne le vecteur de produits
+    const vector<int>& getLignesCatalogue() const;
+    void augmenterTousPrix(int pourcentage); //O(1), voir EchellePrix
+    void appliquerPrix(); //Reporte les augmentations en attente dans le prix de chaque produit
     //setters
     void setPrix(float prx);
     void set_tours(int tours);
     void setStyle_negociacion(int num); //setter pour le style
     void setBalSize(int);
     void set_tKarma(int);
+    void setArenaProduits(shared_ptr<ArenaSession> arena);
     
     //getters
     float getPrix();
@@ -43,16 +78,21 @@ public:
     int getStyle_negociacion();
     int get_tours();
     shared_ptr<BoiteAuLettres> getBoiteAuLettres(int id) const;
+    static bool correspondVoiture(const Voiture& critere, const Voiture& v); //comparaison des produits hors catalogue
     void afficherProduits()const;
      vector<shared_ptr<BoiteAuLettres>> getBoiteAuLettresvec() const;
       void insertBaL(int placement, shared_ptr<BoiteAuLettres> bal);
      float getPrixMin() const { return prix_min; }
      float getPrixMax() const { return prix_max; }
+     shared_ptr<ArenaSession> getArenaProduits() const { return arena_produits; }
 
     //methodes pour negociations
-    shared_ptr<Message> creerMessage(string obj, float offr, string mess,shared_ptr<Produit> prod,int id_achet);
-    shared_ptr<Produit> chercherProduit(shared_ptr<Produit> prod);
-    void negocier(int thread_id, int num_threads);
+    Message creerMessage(Verbe obj, float offr, PoigneeProduit prod,int id_achet);
+    shared_ptr<Produit> chercherProduit(const Produit* prod);
+    vector<shared_ptr<Produit>> chercherProduits(const vector<const Produit*>& recherches); //lot de recherches
+    void chercherEnLot(vector<Conversation>& conversations, int source); //recherches en attente, via chercherProduits
+    Negociation negocier(int thread_id); //coroutine, voir Negociation
+    int boiteEnAttente(const vector<Conversation>& conversations, bool& relance) const; //boite ou un acheteur attend une reponse
 
     //pour la fourchette de prix
     void setFourchettePrix(float min, float max) {
@@ -60,10 +100,10 @@ public:
         prix_max = max;
     }
     //Strategies
-    shared_ptr<Message> neg_search(shared_ptr<Message> dernierMessage, bool &enNegociation, float &prix_minimale,shared_ptr<Produit> &prod);
-    shared_ptr<Message> neg_accept(shared_ptr<Message> dernierMessage, bool &enNegociation);
-    shared_ptr<Message> neg_breakdown(shared_ptr<Message> dernierMessage, bool &enNegociation,int &id_acheteur_en_Negociation);
-    shared_ptr<Message> neg_offre(shared_ptr<Message> dernierMessage,float &prix_cible, float &vendeur_offre_avant,float &acheteur_offre,float &acheteur_offre_avant, float &pasapas, bool &enNegociation, int &nombre_de_tours_max);
+    Message neg_search(const Message& dernierMessage, const shared_ptr<Produit>& trouve, bool &enNegociation, float &prix_minimale,PoigneeProduit &prod);
+    Message neg_accept(const Message& dernierMessage, bool &enNegociation);
+    Message neg_breakdown(const Message& dernierMessage, bool &enNegociation,int &id_acheteur_en_Negociation);
+    Message neg_offre(const Message& dernierMessage,float &prix_cible, float &vendeur_offre_avant,float &acheteur_offre,float &acheteur_offre_avant, float &pasapas, bool &enNegociation, int &nombre_de_tours_max);
 
 };
 
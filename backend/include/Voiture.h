@@ -3,17 +3,20 @@
 
 #include<string>
 #include<iostream>
+#include<memory>
 #include "Produit.h"
+#include "TableChaines.h"
 using namespace std;
 
 class Voiture : public Produit{
 private:
-    string brand;
-    string model;
+    //Chaines internees dans TableChaines
+    IdChaine brand;
+    IdChaine model;
     int year;
-    string boite_de_vitesse;
+    IdChaine boite_de_vitesse;
     int kilometres;
-    string essence;
+    IdChaine essence;
     float mpg;
     float taille_engin;
 
@@ -21,36 +24,51 @@ public:
 
     Voiture(int id, string description, float prix, string categorie, string image,
             string br, string mod, int year, string bdv, int km, string essen, float mpg, float te)
-        : Produit(id, description, prix, categorie, image),  
+        : Produit(TypeProduit::VOITURE, id, description, prix, categorie, image),
+          brand(TableChaines::getInstance().interner(br)), model(TableChaines::getInstance().interner(mod)),
+          year(year), boite_de_vitesse(TableChaines::getInstance().interner(bdv)),
+          kilometres(km), essence(TableChaines::getInstance().interner(essen)), mpg(mpg), taille_engin(te) {
+    }
+
+    //Voiture dont les chaines sont deja internees, sans passer par la table
+    Voiture(int id, string description, float prix, string categorie, string image,
+            IdChaine br, IdChaine mod, int year, IdChaine bdv, int km, IdChaine essen, float mpg, float te)
+        : Produit(TypeProduit::VOITURE, id, description, prix, categorie, image),
           brand(br), model(mod), year(year), boite_de_vitesse(bdv),
           kilometres(km), essence(essen), mpg(mpg), taille_engin(te) {
     }
 
     Voiture()
-        : Produit(0, "", 0.0f, "", ""),
-        brand(""),
-        model(""),
+        : Produit(TypeProduit::VOITURE, 0, "", 0.0f, "", ""),
+        brand(TableChaines::VIDE),
+        model(TableChaines::VIDE),
         year(0),
-        boite_de_vitesse(""),
+        boite_de_vitesse(TableChaines::VIDE),
         kilometres(0),
-        essence(""),
+        essence(TableChaines::VIDE),
         mpg(0.0f),
         taille_engin(0.0f) {
     }
 
 
-    ~Voiture() override;
+    ~Voiture();
 
     // Getter-Methoden
-    string getBrand() const;
-    string getModel() const;
+    const string& getBrand() const;
+    const string& getModel() const;
     int getYear() const; 
-    string getBoiteDeVitesse() const;
+    const string& getBoiteDeVitesse() const;
     int getKilometres() const ;
-    string getEssence() const; 
+    const string& getEssence() const; 
     float getMPG() const;
     float getTailleEngin() const;
 
+    // Identifiants dans TableChaines, pour comparer sans passer par les chaines
+    IdChaine getIdBrand() const { return brand; }
+    IdChaine getIdModel() const { return model; }
+    IdChaine getIdBoiteDeVitesse() const { return boite_de_vitesse; }
+    IdChaine getIdEssence() const { return essence; }
+
     // Setter-Methoden
     void setBrand(const string& b);
     void setModel(const string& m) ;
@@ -61,10 +79,18 @@ public:
     void setMPG(float mpg_val) ;
     void setTailleEngin(float taille) ;
 
-    void afficherTout() const override;
+    void afficherTout() const;
     
 
 };
 
+//Conversions verifiees par le type du produit, sans RTTI : nullptr si le produit n'est pas une voiture
+inline shared_ptr<Voiture> commeVoiture(const shared_ptr<Produit>& p) {
+    return p != nullptr && p->estVoiture() ? static_pointer_cast<Voiture>(p) : nullptr;
+}
+
+inline const Voiture* commeVoiture(const Produit* p) {
+    return p != nullptr && p->estVoiture() ? static_cast<const Voiture*>(p) : nullptr;
+}
 
 #endif
@@ -34,6 +34,7 @@ void affichage_choix_Produits_dispos(std::vector<Produits_dispos> &produits, int
 void affichage_finales(std::vector<std::shared_ptr<BoiteAuLettres>> boites);
 vector<string> readLineFromCSV(const string& filename, int lineNumber) ;
 vector<shared_ptr<BoiteAuLettres>> start_negocier(vector<Acheteur>& acheteur,vector<Vendeur>& vendeur,vector<shared_ptr<Voiture>>& voit);
+int lancer_sans_interface(int nbr_acheteurs, bool acheteurs_simultanes, int capacite_vendeur);
 
 
 #endif // BACK_END_MAIN_H
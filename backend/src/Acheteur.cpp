@@ -16,6 +16,8 @@
 #include "Produit.h"
 #include "Voiture.h"
 #include "Threads_var.h"
+#include "RepertoireVendeurs.h"
+#include "Ordonnanceur.h"
 #include <stdlib.h>
 #include <thread>
 #include <algorithm>
@@ -32,12 +34,14 @@ using namespace std;
  * \param idx Identifiant unique de l'acheteur.
  * \param nombre_vendeur Nombre de vendeurs avec lesquels l'acheteur peut négocier.
  */
-Acheteur::Acheteur(int idx, int nombre_vendeur) {
+Acheteur::Acheteur(int idx, int nombre_vendeur)
+    : aleatoire(GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_ACHETEUR, idx)) {
     acheteur_id = idx;
-    produit = nullptr;
+    produit = PoigneeProduit();
     enNegociation = false;
     strategie = 0;
     prix_cible = 0.0;
+    prix_accord = 0.0f;
     boite_au_lettres.resize(nombre_vendeur);
 }
 
@@ -109,29 +113,52 @@ int Acheteur::getStrat() const {
 /**
  * \brief Obtenir le produit associé à l'acheteur.
  *
- * \return Le produit de l'acheteur.
+ * \return Le produit de l'acheteur, nullptr s'il n'en a pas ou s'il a été libéré.
  */
-shared_ptr<Produit> Acheteur::getProduit() const {
-    return this->produit;
+Produit* Acheteur::getProduit() const {
+    return TableProduits::getInstance().obtenir(produit);
+}
+
+/**
+ * \brief Obtenir le prix convenu de la voiture achetée.
+ *
+ * Le prix est gardé par l'acheteur : la voiture appartient encore au vendeur, qui peut lire son prix pendant
+ * ses recherches jusqu'à ce qu'il traite l'accord.
+ *
+ * \return Le prix convenu, 0 si l'acheteur n'a rien acheté.
+ */
+float Acheteur::getPrixAccord() const {
+    return prix_accord;
+}
+
+/**
+ * \brief Obtenir la poignée du produit associé à l'acheteur.
+ *
+ * \return La poignée du produit dans TableProduits.
+ */
+PoigneeProduit Acheteur::getPoigneeProduit() const {
+    return produit;
 }
 
 /**
  * \brief Définir le produit associé à l'acheteur sous forme de voiture.
  *
+ * La voiture est enregistrée dans TableProduits, où elle reste jusqu'à ce que l'appelant la libère.
+ *
  * \param m Modèle de la voiture.
  * \param b Marque de la voiture.
  * \param prx Prix de la voiture.
  */
 void Acheteur::setProduitVoit(string m, string b, float prx) {
-    produit = make_shared<Voiture>(0, "", prx, "Voiture", "", b, m, 0, "", 0, "", 0, 0);
+    produit = TableProduits::getInstance().enregistrer(make_shared<Voiture>(0, "", prx, "Voiture", "", b, m, 0, "", 0, "", 0, 0));
 }
 
 /**
  * \brief Définir le produit de l'acheteur.
  *
- * \param v Pointeur partagé vers le produit à définir.
+ * \param v Poignée du produit à définir, déjà enregistré dans TableProduits.
  */
-void Acheteur::setProd(shared_ptr<Produit> v) {
+void Acheteur::setProd(PoigneeProduit v) {
     produit = v;
 }
 
@@ -150,13 +177,11 @@ shared_ptr<BoiteAuLettres> Acheteur::getBoiteAuLettres(int id_Vendeur) const {
  *
  * \param obj L'objet du message.
  * \param offr L'offre dans le message.
- * \param mess Le contenu du message.
  * \param id_recep Identifiant du destinataire.
- * \return Un pointeur partagé vers le message créé.
+ * \return Le message créé, copié ensuite dans la boîte aux lettres.
  */
-shared_ptr<Message> Acheteur::creerMessage(string obj, float offr, string mess, int id_recep) {
-    shared_ptr<Message> m = make_shared<Message>(acheteur_id, id_recep, obj, offr, mess, produit);
-    return m;
+Message Acheteur::creerMessage(Verbe obj, float offr, int id_recep) {
+    return Message(acheteur_id, id_recep, obj, offr, produit);
 }
 
 /**
@@ -177,20 +202,29 @@ vector<shared_ptr<BoiteAuLettres>> Acheteur::getBoiteAuLettresvec() const {
  * \param thread_id L'identifiant du thread d'acheteur.
  * \param num_threads Le nombre total de threads acheteur.
  * \param bal_finale Le vecteur de boîtes aux lettres finales des acheteurs.
+ *
+ * C'est une coroutine : chaque attente d'un vendeur est un co_await sur l'événement de l'acheteur, qui rend le
+ * thread à l'Ordonnanceur tant qu'aucun vendeur n'a répondu.
+ *
+ * \return La négociation, suspendue jusqu'à Negociation::demarrer.
  */
 
 //Logique pour negociations
 
 //Logique coeur
-void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<BoiteAuLettres>> &bal_finale){
-    float prix=produit->getPrix();
+Negociation Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<BoiteAuLettres>> &bal_finale){
+    Evenement& reveil = *evenements_Achet[thread_id];
+    shared_ptr<CollecteOffres> collecte=collectes_Achet[thread_id]; //Reponses a la recherche
+    float prix=getProduit()->getPrix();
     prix_cible=prix;
 
-    shared_ptr<Message> m=nullptr;
-    shared_ptr<Message> dernierMessage=nullptr;
+    Message m;
+    Message dernierMessage;
 
     int id_VendeurEnNegociation=-1;
     vector<int> vendeurs_en_neg={};
+    vector<int> candidats={}; //Vendeurs contactes, les autres n'ont aucun produit correspondant
+    vector<int> repondants={}; //Candidats dont la reponse est arrivee a temps
     float vendeur_offre=0.0f;
     float vendeur_offre_avant=-1;
     float acheteur_offre=0.0f;
@@ -205,76 +239,85 @@ void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<Boite
     int tours_maximales=0;
     int tours_obligation_acheter=0;
     int negocier_en_meme_temps=0;
+    bool simultanes=false; //Tous les acheteurs negocient en meme temps
 
     float pas=0.0f; //utilisée que par strategie pas a pas
 
 
     //Phase faire appel aux vendeurs
     {
-        {
-            cout<<"Acheteur "<<thread_id<<"stop (acheteur.cpp 119)"<<endl;        //
-            std::unique_lock<std::mutex> lock(mtx);
-            child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-            cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 122)"<<endl;        //
-        }
+        co_await reveil.attendre();
 
         tours_maximales=boite_au_lettres[0]->getProtocol()->getNbrTours();
         tours_obligation_acheter=boite_au_lettres[0]->getProtocol()->getNbrOblAchet();
         negocier_en_meme_temps=boite_au_lettres[0]->getProtocol()->getNegMemeTemps();
+        simultanes=boite_au_lettres[0]->getProtocol()->isAcheteursSimultanes();
 
 
-        for (int i = 0; i < boite_au_lettres.size(); i++)
+        //La recherche n'est envoyee qu'aux vendeurs du repertoire, les autres valent un break-down implicite
+        candidats=RepertoireVendeurs::getInstance().candidats(*commeVoiture(getProduit()));
+        RepertoireVendeurs::getInstance().compterRecherche(static_cast<int>(candidats.size()));
+        //Tous les candidats repondent en meme temps, la collecte reveille l'acheteur une seule fois
+        //Elle est ouverte avant d'ecrire : un vendeur deja reveille peut trouver la recherche avant son signal
+        if(num_threads>0 && !candidats.empty()){
+            collecte->ouvrir(static_cast<int>(candidats.size()), boite_au_lettres[0]->getProtocol()->getOffresSuffisantes(), &reveil);
+        }
+        for (int i : candidats)
         {
 
-            m = creerMessage("search", 0 , "",i);
-            boite_au_lettres[i]->laisserMessage(m);
+            m = creerMessage(Verbe::SEARCH, 0, i);
+            boite_au_lettres[i]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
         }
 
 
-        if(num_threads>0){
-            *child_ready_flags_Vend[0] = true;
-            *child_ready_flags_Achet[thread_id] = false;
-            child_Vend_cvs[0]->notify_one();
-            cout<<"Acheteur"<<thread_id<<"-> Vendeur "<<0<<"notifie (acheteur.cpp 135)"<<endl;
-
-
+        if(num_threads>0 && !candidats.empty()){
+            reveil.consommer();
+            for (int i : candidats)
+            {
+                evenements_Vend[i]->signaler();
+            }
+            int delai=boite_au_lettres[0]->getProtocol()->getDelaiRecherche();
+            if(delai>0){
+                Ordonnanceur::getInstance().soumettreApres(chrono::milliseconds(delai), [collecte] { collecte->expirer(); });
+            }
         }
     }
 
     //Phase choisir le vendeur avec la meilleure offre et faire premiere offre
     {
-        {
-            cout<<"Acheteur "<<thread_id<<"stop (acheteur.cpp 143)"<<endl;
-            std::unique_lock<std::mutex> lock(mtx);
-            child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-            cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 146)"<<endl;
+        co_await reveil.attendre();
+        //Seuls les vendeurs arrives avant la fermeture de la collecte sont lus, les autres terminent seuls
+        if(num_threads>0 && !candidats.empty()){
+            repondants=collecte->getRepondants();
         }
 
-        for (int i = 0; i < boite_au_lettres.size(); i++)
+        //Offres lues une seule fois : le classement se fait sur cette copie, pas sur les boites
+        vector<float> offres(boite_au_lettres.size(), 0.0f);
+        for (int i : repondants)
         {
-            if(boite_au_lettres[i]->dernierMessage()->getObjet()=="offer" && boite_au_lettres[i]->dernierMessage()->getOffre() != 0)
+            const Message reponse=boite_au_lettres[i]->dernierMessage();
+            offres[i]=reponse.getOffre();
+            if(reponse.getObjet()==Verbe::OFFER && reponse.getOffre() != 0)
             {
                 vendeurs_en_neg.push_back(i);
             }
         }
         std::sort(vendeurs_en_neg.begin(), vendeurs_en_neg.end(),
-                  [this](const int& a, const int& b) {
-                      return boite_au_lettres[a]->dernierMessage()->getOffre() < boite_au_lettres[b]->dernierMessage()->getOffre();
+                  [&offres](const int& a, const int& b) {
+                      return offres[a] < offres[b];
                   });
 
         if(vendeurs_en_neg.size()>negocier_en_meme_temps){
             vendeurs_en_neg.resize(negocier_en_meme_temps);
         }
 
-        for (int i = 0; i < boite_au_lettres.size(); i++)
+        for (int i : repondants)
         {
             if(!std::any_of(vendeurs_en_neg.begin(), vendeurs_en_neg.end(), [i](int val){return val==i;})){
                 m=neg_breakdown(boite_au_lettres[i]->dernierMessage());
-                boite_au_lettres[i]->laisserMessage(m);
+                boite_au_lettres[i]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
                 {
-                    std::lock_guard<std::mutex> lock(mtx);
-                    *child_ready_flags_Vend[i] = true;
-                    child_Vend_cvs[i]->notify_one();
+                    evenements_Vend[i]->signaler();
                 }
             }
         }
@@ -283,25 +326,17 @@ void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<Boite
             enNegociation=true;
             for(int i=0;i<vendeurs_en_neg.size();i++){
                 if(i!=0){
-                    {
-                        cout<<"Acheteur "<<thread_id<<"stop (acheteur.cpp 183)"<<endl;
-                        std::unique_lock<std::mutex> lock(mtx);
-                        child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-                        cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 143)"<<endl;
-                    }
+                    co_await reveil.attendre();
                 }
 
                 dernierMessage=boite_au_lettres[vendeurs_en_neg[i]]->dernierMessage();
-                vendeur_offre=dernierMessage->getOffre();
+                vendeur_offre=dernierMessage.getOffre();
                 m=neg_offre(dernierMessage, prix,vendeur_offre_avant,vendeur_offre,acheteur_offre_avant, pas,nbr_tours,tours_maximales,tours_obligation_acheter);
-                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m);
+                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
 
                 {
-                    std::lock_guard<std::mutex> lock(mtx);
-                    *child_ready_flags_Achet[thread_id] = false;
-                    *child_ready_flags_Vend[vendeurs_en_neg[i]] = true;
-                    child_Vend_cvs[vendeurs_en_neg[i]]->notify_one();
-                    cout<<"Acheteur"<<thread_id<<"-> Vendeur "<<vendeurs_en_neg[i]<<"notifie (acheteur.cpp 175)"<<endl;        //
+                    reveil.consommer();
+                    evenements_Vend[vendeurs_en_neg[i]]->signaler();
 
                 }
 
@@ -319,52 +354,45 @@ void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<Boite
         for(int i=0;i<vendeurs_en_neg.size();i++){
             //logique
 
-            {
-                cout<<"Acheteur "<<thread_id<<"stop (acheteur.cpp 183)"<<endl;
-                std::unique_lock<std::mutex> lock(mtx);
-                child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-                cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 143)"<<endl;
-            }
+            co_await reveil.attendre();
 
             dernierMessage=boite_au_lettres[vendeurs_en_neg[i]]->dernierMessage();
-            vendeur_offre=dernierMessage->getOffre();
+            vendeur_offre=dernierMessage.getOffre();
 
 
-            if(dernierMessage->getObjet()=="offer"&&vendeur_offre_avant!=vendeur_offre&&nbr_tours<tours_maximales&&(nbr_tours+1)==tours_obligation_acheter&&abs(vendeur_offre-prix_cible)>threshold){
-                cout<<"Acheteur "<<thread_id<<" offer obligation ->"<<vendeurs_en_neg[i]<<endl;
+            if(dernierMessage.getObjet()==Verbe::OFFER&&vendeur_offre_avant!=vendeur_offre&&nbr_tours<tours_maximales&&(nbr_tours+1)==tours_obligation_acheter&&abs(vendeur_offre-prix_cible)>threshold){
                 m=neg_breakdown(dernierMessage);
                 breakdown.push_back(vendeurs_en_neg[i]);
-                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m);
-            }else if (dernierMessage->getObjet()=="offer"&&vendeur_offre_avant!=vendeur_offre&&nbr_tours<tours_maximales&&dernierMessage->getOffre()>prix_cible)
+                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
+            }else if (dernierMessage.getObjet()==Verbe::OFFER&&vendeur_offre_avant!=vendeur_offre&&nbr_tours<tours_maximales&&dernierMessage.getOffre()>prix_cible)
             {
-                cout<<"Acheteur "<<thread_id<<" offer "<<vendeurs_en_neg[i]<<endl;
 
                 m=neg_offre(dernierMessage,prix,vendeur_offre_avant,vendeur_offre,acheteur_offre_avant,pas,nbr_tours,tours_maximales,tours_obligation_acheter);
-                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m);
+                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
 
             }
-            else if (dernierMessage->getObjet()=="accept"||nbr_tours>=tours_maximales&&nbr_tours>=tours_obligation_acheter||dernierMessage->getOffre()<=prix_cible&&acceptCheck(acheteur_offre_avant,vendeur_offre)&&dernierMessage->getObjet()=="offer")
+            else if (dernierMessage.getObjet()==Verbe::ACCEPT||nbr_tours>=tours_maximales&&nbr_tours>=tours_obligation_acheter||dernierMessage.getOffre()<=prix_cible&&acceptCheck(acheteur_offre_avant,vendeur_offre)&&dernierMessage.getObjet()==Verbe::OFFER)
             {
-                cout<<"Acheteur "<<thread_id<<" accept "<<vendeurs_en_neg[i]<<endl;
                 accepts.push_back(vendeurs_en_neg[i]);
                 notify=false;
                 //m=neg_accept(dernierMessage);
             }
-            else if (dernierMessage->getObjet()=="break-down"||dernierMessage->getObjet()=="offer"&&vendeur_offre_avant==vendeur_offre||nbr_tours>=tours_maximales&&nbr_tours<tours_obligation_acheter)
+            else if (dernierMessage.getObjet()==Verbe::BREAK_DOWN||dernierMessage.getObjet()==Verbe::OFFER&&vendeur_offre_avant==vendeur_offre||nbr_tours>=tours_maximales&&nbr_tours<tours_obligation_acheter)
             {
-                cout<<"Acheteur "<<thread_id<<" break down"<<vendeurs_en_neg[i]<<endl;
                 m=neg_breakdown(dernierMessage);
                 breakdown.push_back(vendeurs_en_neg[i]);
-                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m);
+                boite_au_lettres[vendeurs_en_neg[i]]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
+            }
+            else
+            {
+                //Rien a repondre : le vendeur est reveille sans message et relit sa derniere offre
+                boite_au_lettres[vendeurs_en_neg[i]]->relancer();
             }
             if(notify){
                 {
-                    std::lock_guard<std::mutex> lock(mtx);
 
-                    *child_ready_flags_Achet[thread_id] = false;
-                    *child_ready_flags_Vend[vendeurs_en_neg[i]] = true;
-                    cout<<"Acheteur"<<thread_id<<"-> Vendeur "<<vendeurs_en_neg[i]<<"notifie (acheteur.cpp 280)"<<endl;
-                    child_Vend_cvs[vendeurs_en_neg[i]]->notify_one();
+                    reveil.consommer();
+                    evenements_Vend[vendeurs_en_neg[i]]->signaler();
                 }
             }
             notify=true;
@@ -388,27 +416,21 @@ void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<Boite
                                              return std::find(breakdown.begin(), breakdown.end(), x) != breakdown.end();
                                          }), accepts.end());
 
-    {
-        cout<<"Acheteur "<<thread_id<<"stop dehors (acheteur.cpp 226)"<<endl;
-        std::unique_lock<std::mutex> lock(mtx);
-        child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-        cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 229)"<<endl;
-    }
+    co_await reveil.attendre();
 
     if(!accepts.empty()){
 
+        vector<float> offres(boite_au_lettres.size(), 0.0f);
+        for (int i : accepts) {
+            offres[i]=boite_au_lettres[i]->dernierMessage().getOffre();
+        }
         std::sort(accepts.begin(), accepts.end(),
-                  [this](const int& a, const int& b) {
-                      return boite_au_lettres[a]->dernierMessage()->getOffre() < boite_au_lettres[b]->dernierMessage()->getOffre();
+                  [&offres](const int& a, const int& b) {
+                      return offres[a] < offres[b];
                   });
 
         for (int i = 0; i < accepts.size(); ++i) {
-            {
-                cout<<"Acheteur "<<thread_id<<"stop dehors (acheteur.cpp 226)"<<endl;
-                std::unique_lock<std::mutex> lock(mtx);
-                child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-                cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 229)"<<endl;
-            }
+            co_await reveil.attendre();
 
             if(i==0){
                 m= neg_accept(boite_au_lettres[accepts[i]]->dernierMessage());
@@ -416,40 +438,28 @@ void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<Boite
                 m=neg_breakdown(boite_au_lettres[accepts[i]]->dernierMessage());
 
             }
-            boite_au_lettres[accepts[i]]->laisserMessage(m);
+            boite_au_lettres[accepts[i]]->laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
 
             {
-                std::lock_guard<std::mutex> lock(mtx);
 
-                *child_ready_flags_Achet[thread_id] = false;
-                *child_ready_flags_Vend[accepts[i]] = true;
-                cout<<"Acheteur"<<thread_id<<"-> Vendeur "<<accepts[i]<<"notifie (acheteur.cpp 333)"<<endl;
-                child_Vend_cvs[accepts[i]]->notify_one();
+                reveil.consommer();
+                evenements_Vend[accepts[i]]->signaler();
             }
         }
 
-        {
-            cout<<"Acheteur "<<thread_id<<"stop dehors (acheteur.cpp 226)"<<endl;
-            std::unique_lock<std::mutex> lock(mtx);
-            child_Achet_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Achet[thread_id]->load(); });
-            cout<<"Acheteur "<<thread_id<<"continue (acheteur.cpp 229)"<<endl;
-        }
+        co_await reveil.attendre();
         bal_finale[thread_id]=boite_au_lettres[accepts[0]];
-        setProd(bal_finale[thread_id]->getMessage(1)->getProduit());
-        getProduit()->setPrix(bal_finale[thread_id]->dernierMessage()->getOffre());
+        setProd(bal_finale[thread_id]->getMessage(1).getPoigneeProduit());
+        prix_accord=bal_finale[thread_id]->dernierMessage().getOffre();
     }else{
-        getProduit()->setPrix(0.0);
+        prix_accord=0.0f;
 
     }
-    cout<<"===========Acheteur ID"<<thread_id<<"termine============================================================================================="<<endl;
 
-    {
-        std::lock_guard<std::mutex> lock(mtx);
+    if(!simultanes){
         thread_id++;
         if(thread_id<num_threads){
-            *child_ready_flags_Achet[thread_id] = true;
-            cout<<"Achet "<<thread_id<<"notifie (acheteur.cpp 358)"<<endl;
-            child_Achet_cvs[thread_id]->notify_one();
+            evenements_Achet[thread_id]->signaler();
         }
     }
 
@@ -474,16 +484,15 @@ void Acheteur::negocier( int thread_id,int num_threads,  vector<shared_ptr<Boite
  */
 
 //Methodes reponses
-shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float &prix_cible, float &vendeur_offre_avant,float &vendeur_offre,float &acheteur_offre_avant, float &pasapas, int &nbrtours,int &nombre_tours_max, int& tours_obligation_acheter){
-    std::lock_guard<std::mutex> lock(mtx); // Automatisch freigeben
+Message Acheteur::neg_offre(const Message& dernierMessage,float &prix_cible, float &vendeur_offre_avant,float &vendeur_offre,float &acheteur_offre_avant, float &pasapas, int &nbrtours,int &nombre_tours_max, int& tours_obligation_acheter){
     float offre_nouvelle=0.0f;
-    string objet="";
+    Verbe objet=Verbe::AUCUN;
     int min=0,max=0;
     float comm=0.0f;
 
     if(acheteur_offre_avant==-1){   //Premier offre du acheteur
 
-        objet="offer";
+        objet=Verbe::OFFER;
 
         switch (strategie)
         {
@@ -491,7 +500,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
             //contre "offer"
             min=60;
             max=80;
-            comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+            comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
             offre_nouvelle=prix_cible*comm;
             pasapas=(prix_cible-offre_nouvelle)/nombre_tours_max;
             break;
@@ -500,7 +509,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
 
             min=70;
             max=50;
-            comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+            comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
             offre_nouvelle=prix_cible*comm;
             break;
 
@@ -508,7 +517,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
 
             min=10;
             max=20;
-            comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+            comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
             offre_nouvelle=prix_cible*comm;
 
             break;
@@ -517,7 +526,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
 
             min=60;
             max=80;
-            comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+            comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
             offre_nouvelle=prix_cible*comm;
             break;
 
@@ -525,7 +534,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
 
             min=80;
             max=95;
-            comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+            comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
             offre_nouvelle=prix_cible*comm;
 
             break;
@@ -541,7 +550,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
     }else{      //A partir du premier offre
 
 
-        objet="offer";
+        objet=Verbe::OFFER;
 
         switch (strategie)
         {
@@ -561,7 +570,7 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
 
             min=105;
             max=110;
-            comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+            comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
             offre_nouvelle=acheteur_offre_avant*comm;
 
             break;
@@ -594,21 +603,19 @@ shared_ptr<Message> Acheteur::neg_offre(shared_ptr<Message> dernierMessage,float
     }
     vendeur_offre_avant=vendeur_offre;
     acheteur_offre_avant=offre_nouvelle;
-    return creerMessage(objet,offre_nouvelle,"",dernierMessage->getIdEmmeteur());
+    return creerMessage(objet,offre_nouvelle,dernierMessage.getIdEmmeteur());
 
 }
 
-shared_ptr<Message> Acheteur::neg_accept(shared_ptr<Message> dernierMessage){
-    std::lock_guard<std::mutex> lock(mtx); // Automatisch freigeben
+Message Acheteur::neg_accept(const Message& dernierMessage){
     enNegociation=false;
-    setProd(dernierMessage->getProduit());
-    getProduit()->setPrix(dernierMessage->getOffre());
-    return creerMessage("accept",dernierMessage->getOffre(),"",dernierMessage->getIdEmmeteur());
+    setProd(dernierMessage.getPoigneeProduit());
+    prix_accord=dernierMessage.getOffre();
+    return creerMessage(Verbe::ACCEPT,dernierMessage.getOffre(),dernierMessage.getIdEmmeteur());
 }
 
-shared_ptr<Message> Acheteur::neg_breakdown(shared_ptr<Message> dernierMessage){
-    std::lock_guard<std::mutex> lock(mtx); // Automatisch freigeben
-    return creerMessage("break-down",0,"",dernierMessage->getIdEmmeteur());
+Message Acheteur::neg_breakdown(const Message& dernierMessage){
+    return creerMessage(Verbe::BREAK_DOWN,0,dernierMessage.getIdEmmeteur());
 }
 
 bool Acheteur::acceptCheck(float& dernierOffre,float& vendeur_offre){
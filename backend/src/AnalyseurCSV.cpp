@@ -0,0 +1,390 @@
+/**
+ * @file AnalyseurCSV.cpp
+ * @brief Implémentation de la classe AnalyseurCSV, lecture rapide des fichiers CSV de voitures.
+ *
+ * Le contenu est parcouru par blocs de 64 octets : pour chaque bloc, un masque de 64 bits marque les ',' et
+ * les '\n' (comparaisons SSE2 ou AVX2 selon le processeur, boucle simple sinon). Les champs sont ensuite
+ * découpés en consommant les bits du masque, sans copie, et les nombres sont lus sur place avec std::from_chars,
+ * qui ne dépend pas de la locale (QApplication l'initialise depuis l'environnement, ce qui faussait stof).
+ * Les colonnes sont associées au schéma par leur nom dans l'en-tête, ce qui accepte par exemple "tax(£)".
+ * Les champs entre guillemets ne sont pas gérés, les fichiers de data/ n'en contiennent pas.
+ */
+
+#include "AnalyseurCSV.h"
+#include <charconv>
+#include <cstring>
+#include <cctype>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ANALYSEUR_CSV_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ATTRIBUT_AVX2 __attribute__((target("avx2")))
+#else
+#define ATTRIBUT_AVX2
+#endif
+
+using namespace std;
+
+namespace {
+
+const size_t TAILLE_BLOC = 64;
+
+typedef uint64_t (*FonctionMasque)(const char*);
+
+atomic<bool> scalaire_force(false);     // Voir AnalyseurCSV::forcerScalaire
+
+// Noms des colonnes du schéma, dans l'ordre de AnalyseurCSV::Champ
+const char* const NOMS_CHAMPS[AnalyseurCSV::NBR_CHAMPS] = {
+    "model", "year", "price", "transmission", "mileage", "fueltype", "tax", "mpg", "enginesize"
+};
+
+uint64_t masqueScalaire(const char* p) {
+    uint64_t masque = 0;
+    for (size_t i = 0; i < TAILLE_BLOC; i++) {
+        if (p[i] == ',' || p[i] == '\n') {
+            masque |= uint64_t(1) << i;
+        }
+    }
+    return masque;
+}
+
+#ifdef ANALYSEUR_CSV_X86
+uint64_t masqueSSE2(const char* p) {
+    const __m128i virgule = _mm_set1_epi8(',');
+    const __m128i ligne = _mm_set1_epi8('\n');
+    uint64_t masque = 0;
+    for (size_t i = 0; i < TAILLE_BLOC; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i egal = _mm_or_si128(_mm_cmpeq_epi8(v, virgule), _mm_cmpeq_epi8(v, ligne));
+        masque |= uint64_t(uint32_t(_mm_movemask_epi8(egal))) << i;
+    }
+    return masque;
+}
+
+ATTRIBUT_AVX2 uint64_t masqueAVX2(const char* p) {
+    const __m256i virgule = _mm256_set1_epi8(',');
+    const __m256i ligne = _mm256_set1_epi8('\n');
+    __m256i bas = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i haut = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    __m256i egal_bas = _mm256_or_si256(_mm256_cmpeq_epi8(bas, virgule), _mm256_cmpeq_epi8(bas, ligne));
+    __m256i egal_haut = _mm256_or_si256(_mm256_cmpeq_epi8(haut, virgule), _mm256_cmpeq_epi8(haut, ligne));
+    return uint64_t(uint32_t(_mm256_movemask_epi8(egal_bas)))
+         | (uint64_t(uint32_t(_mm256_movemask_epi8(egal_haut))) << 32);
+}
+
+bool supporteAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int infos[4];
+    __cpuid(infos, 1);
+    bool osxsave = (infos[2] & (1 << 27)) != 0;
+    bool avx = (infos[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(infos, 7, 0);
+    return (infos[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+/**
+ * @brief Choisit une fois pour toutes la version du calcul de masque adaptée au processeur.
+ * @return La fonction de calcul du masque d'un bloc, la boucle simple si elle est forcée.
+ */
+FonctionMasque fonctionMasque() {
+#ifdef ANALYSEUR_CSV_X86
+    static const FonctionMasque fonction = supporteAVX2() ? masqueAVX2 : masqueSSE2;
+#else
+    static const FonctionMasque fonction = masqueScalaire;
+#endif
+    return scalaire_force.load(memory_order_relaxed) ? masqueScalaire : fonction;
+}
+
+/**
+ * @brief Calcule le masque d'un bloc, éventuellement incomplet en fin de contenu.
+ * @param p Le début du bloc.
+ * @param reste Le nombre d'octets restants à partir de p.
+ * @return Un bit par octet, à 1 pour ',' et '\n'.
+ */
+uint64_t masqueBloc(const char* p, size_t reste) {
+    if (reste >= TAILLE_BLOC) {
+        return fonctionMasque()(p);
+    }
+    char copie[TAILLE_BLOC] = {};
+    memcpy(copie, p, reste);
+    return fonctionMasque()(copie);
+}
+
+int premierBit(uint64_t masque) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(masque);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long indice;
+    _BitScanForward64(&indice, masque);
+    return static_cast<int>(indice);
+#else
+    int indice = 0;
+    while ((masque & 1) == 0) {
+        masque >>= 1;
+        indice++;
+    }
+    return indice;
+#endif
+}
+
+bool lireEntier(string_view champ, int& valeur) {
+    const char* fin = champ.data() + champ.size();
+    auto resultat = from_chars(champ.data(), fin, valeur);
+    return resultat.ec == errc() && resultat.ptr == fin;
+}
+
+bool lireReel(string_view champ, float& valeur) {
+    const char* fin = champ.data() + champ.size();
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto resultat = from_chars(champ.data(), fin, valeur);
+    return resultat.ec == errc() && resultat.ptr == fin;
+#else
+    // Bibliothèque sans from_chars pour les réels : lecture décimale simple, elle aussi indépendante de la locale
+    const char* p = champ.data();
+    bool negatif = p < fin && *p == '-';
+    if (negatif) {
+        p++;
+    }
+    double v = 0.0;
+    double echelle = 1.0;
+    bool chiffre = false;
+    bool virgule = false;
+    for (; p < fin; p++) {
+        if (*p >= '0' && *p <= '9') {
+            chiffre = true;
+            v = v * 10.0 + (*p - '0');
+            if (virgule) {
+                echelle *= 10.0;
+            }
+        } else if (*p == '.' && !virgule) {
+            virgule = true;
+        } else {
+            return false;
+        }
+    }
+    valeur = static_cast<float>((negatif ? -v : v) / echelle);
+    return chiffre;
+#endif
+}
+
+}
+
+/**
+ * @brief Constructeur de l'analyseur sur un contenu en mémoire.
+ *
+ * Le contenu doit rester valide pendant toute la durée de l'analyse et de l'utilisation des lignes lues.
+ * @param contenu Le contenu du fichier CSV.
+ */
+AnalyseurCSV::AnalyseurCSV(string_view contenu)
+    : debut(contenu.data()), fin(contenu.data() + contenu.size()), position(contenu.data()), bloc(contenu.data()),
+      masque(0), nbr_colonnes(0) {
+    for (int i = 0; i < MAX_COLONNES; i++) {
+        champs[i] = -1;
+    }
+    if (debut < fin) {
+        masque = masqueBloc(bloc, fin - bloc);
+    }
+}
+
+/**
+ * @brief Indique le nom du jeu d'instructions utilisé pour chercher les séparateurs.
+ * @return "AVX2", "SSE2" ou "scalaire".
+ */
+const char* AnalyseurCSV::getJeuInstructions() {
+#ifdef ANALYSEUR_CSV_X86
+    FonctionMasque fonction = fonctionMasque();
+    return fonction == masqueAVX2 ? "AVX2" : fonction == masqueSSE2 ? "SSE2" : "scalaire";
+#else
+    return "scalaire";
+#endif
+}
+
+/**
+ * @brief Force la boucle simple à la place des versions SSE2/AVX2, pour les comparer dans les tests.
+ *
+ * À changer entre deux analyses seulement : un analyseur en cours mélangerait les deux versions.
+ * @param scalaire True pour la boucle simple, false pour revenir au choix selon le processeur.
+ */
+void AnalyseurCSV::forcerScalaire(bool scalaire) {
+    scalaire_force.store(scalaire, memory_order_relaxed);
+}
+
+/**
+ * @brief Retrouve le champ du schéma correspondant à un nom de colonne.
+ *
+ * La comparaison ignore la casse, les espaces autour du nom et une unité entre parenthèses ("tax(£)" = "tax").
+ * @param nom Le nom de la colonne dans l'en-tête.
+ * @return Le champ, ou -1 si la colonne ne fait pas partie du schéma.
+ */
+int AnalyseurCSV::trouverChamp(string_view nom) {
+    // Marque d'ordre des octets UTF-8 éventuelle en tête de fichier
+    if (nom.size() >= 3 && nom.substr(0, 3) == "\xEF\xBB\xBF") {
+        nom.remove_prefix(3);
+    }
+    size_t parenthese = nom.find('(');
+    if (parenthese != string_view::npos) {
+        nom = nom.substr(0, parenthese);
+    }
+    while (!nom.empty() && isspace(static_cast<unsigned char>(nom.front()))) {
+        nom.remove_prefix(1);
+    }
+    while (!nom.empty() && isspace(static_cast<unsigned char>(nom.back()))) {
+        nom.remove_suffix(1);
+    }
+
+    string minuscules(nom);
+    for (char& c : minuscules) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    for (int i = 0; i < NBR_CHAMPS; i++) {
+        if (minuscules == NOMS_CHAMPS[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Avance jusqu'au prochain séparateur (',' ou '\n').
+ * @return La position du séparateur, ou la fin du contenu.
+ */
+const char* AnalyseurCSV::prochainSeparateur() {
+    while (masque == 0) {
+        if (static_cast<size_t>(fin - bloc) <= TAILLE_BLOC) {
+            return fin;
+        }
+        bloc += TAILLE_BLOC;
+        masque = masqueBloc(bloc, fin - bloc);
+    }
+    const char* separateur = bloc + premierBit(masque);
+    masque &= masque - 1;
+    return separateur;
+}
+
+/**
+ * @brief Découpe la prochaine ligne en colonnes, sans interpréter les valeurs.
+ * @param colonnes Tableau de MAX_COLONNES champs à remplir.
+ * @param nbr Le nombre de colonnes de la ligne.
+ * @return Faux si le contenu est épuisé.
+ */
+bool AnalyseurCSV::lireLigneBrute(string_view* colonnes, int& nbr) {
+    nbr = 0;
+    if (position >= fin) {
+        return false;
+    }
+    while (true) {
+        const char* separateur = prochainSeparateur();
+        bool fin_ligne = separateur == fin || *separateur == '\n';
+        const char* fin_champ = separateur;
+        if (fin_ligne && fin_champ > position && fin_champ[-1] == '\r') {
+            fin_champ--;
+        }
+        if (nbr < MAX_COLONNES) {
+            colonnes[nbr] = string_view(position, fin_champ - position);
+        }
+        nbr++;
+        position = (separateur == fin) ? fin : separateur + 1;
+        if (fin_ligne) {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Lit l'en-tête et associe chaque colonne à un champ du schéma.
+ *
+ * Les colonnes inconnues sont ignorées, l'ordre des colonnes peut donc varier d'un fichier à l'autre.
+ * @return True si tous les champs du schéma ont été trouvés.
+ */
+bool AnalyseurCSV::lireEnTete() {
+    string_view colonnes[MAX_COLONNES];
+    if (!lireLigneBrute(colonnes, nbr_colonnes) || nbr_colonnes > MAX_COLONNES) {
+        return false;
+    }
+    bool trouves[NBR_CHAMPS] = {};
+    for (int i = 0; i < nbr_colonnes; i++) {
+        champs[i] = trouverChamp(colonnes[i]);
+        if (champs[i] >= 0) {
+            if (trouves[champs[i]]) {
+                champs[i] = -1;     // Colonne en double, seule la première compte
+            } else {
+                trouves[champs[i]] = true;
+            }
+        }
+    }
+    for (int i = 0; i < NBR_CHAMPS; i++) {
+        if (!trouves[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reprend l'association des colonnes d'un autre analyseur.
+ *
+ * Permet de découper un fichier en morceaux analysés séparément : seul le premier lit l'en-tête.
+ * @param autre L'analyseur qui a lu l'en-tête du fichier.
+ */
+void AnalyseurCSV::utiliserEnTete(const AnalyseurCSV& autre) {
+    nbr_colonnes = autre.nbr_colonnes;
+    for (int i = 0; i < MAX_COLONNES; i++) {
+        champs[i] = autre.champs[i];
+    }
+}
+
+/**
+ * @brief Lit la ligne de données suivante.
+ *
+ * Une ligne dont le nombre de colonnes ne correspond pas à l'en-tête, ou dont un nombre est illisible,
+ * est rendue avec valide à false.
+ * @param ligne La ligne à remplir.
+ * @return Faux si le contenu est épuisé.
+ */
+bool AnalyseurCSV::suivante(LigneCSV& ligne) {
+    string_view colonnes[MAX_COLONNES];
+    int nbr;
+    if (!lireLigneBrute(colonnes, nbr)) {
+        return false;
+    }
+    ligne.valide = nbr == nbr_colonnes;
+    for (int i = 0; i < nbr_colonnes && ligne.valide; i++) {
+        switch (champs[i]) {
+        case MODELE: ligne.modele = colonnes[i]; break;
+        case ANNEE: ligne.valide = lireEntier(colonnes[i], ligne.annee); break;
+        case PRIX: ligne.valide = lireReel(colonnes[i], ligne.prix); break;
+        case BOITE: ligne.boite = colonnes[i]; break;
+        case KILOMETRES: ligne.valide = lireEntier(colonnes[i], ligne.kilometres); break;
+        case ESSENCE: ligne.essence = colonnes[i]; break;
+        case TAXE: ligne.valide = lireEntier(colonnes[i], ligne.taxe); break;
+        case MPG: ligne.valide = lireReel(colonnes[i], ligne.mpg); break;
+        case TAILLE_ENGIN: ligne.valide = lireReel(colonnes[i], ligne.taille_engin); break;
+        default: break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Récupère le nombre d'octets déjà consommés.
+ * @return La position dans le contenu.
+ */
+size_t AnalyseurCSV::getPosition() const {
+    return position - debut;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file ArenaSession.cpp
+ * @brief Implémentation de la classe ArenaSession, allocation monotone des objets d'une session.
+ *
+ * L'initialisation des vendeurs crée une voiture par annonce. Au lieu d'autant d'allocations et de libérations
+ * séparées sur le tas, ces objets sont pris, avec leur bloc de contrôle (allocate_shared), dans de gros blocs de
+ * l'arène de la session. Les messages, copiés par valeur, n'ont plus besoin d'arène.
+ *
+ * L'arène ne réutilise jamais la mémoire rendue : elle se contente de compter. Chaque objet garde l'arène en vie
+ * par son allocateur, les blocs sont donc tous rendus d'un coup à la destruction du dernier objet de la session.
+ * Les statistiques (objets, octets, pics) servent à dimensionner les blocs.
+ */
+
+#include "ArenaSession.h"
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Constructeur. Aucun bloc n'est réservé avant la première allocation.
+ * @param taille_bloc Taille des blocs en octets.
+ */
+ArenaSession::ArenaSession(size_t taille_bloc)
+    : taille_bloc(taille_bloc), courant(nullptr), fin(nullptr) {}
+
+/**
+ * @brief Destructeur, rend tous les blocs.
+ */
+ArenaSession::~ArenaSession() {
+    for (char* b : blocs) {
+        ::operator delete(b);
+    }
+}
+
+/**
+ * @brief Réserve un nouveau bloc et l'ajoute à la liste.
+ * @param taille Taille du bloc en octets.
+ * @return Le début du bloc.
+ */
+char* ArenaSession::nouveauBloc(size_t taille) {
+    char* b = static_cast<char*>(::operator new(taille));
+    blocs.push_back(b);
+    stats.octets_reserves += taille;
+    stats.blocs++;
+    return b;
+}
+
+/**
+ * @brief Alloue un objet dans le bloc courant, ou dans un nouveau bloc s'il ne reste pas assez de place.
+ *
+ * Un objet de plus du quart d'un bloc reçoit son propre bloc, pour ne pas abandonner la fin du bloc courant.
+ *
+ * @param taille Taille de l'objet en octets.
+ * @param alignement Alignement de l'objet (au plus celui de operator new).
+ * @return L'adresse de l'objet.
+ */
+void* ArenaSession::allouer(size_t taille, size_t alignement) {
+    lock_guard<mutex> lock(mtx);
+    stats.objets++;
+    stats.objets_vivants++;
+    stats.octets += taille;
+    stats.octets_vivants += taille;
+    if (stats.objets_vivants > stats.pic_objets_vivants) {
+        stats.pic_objets_vivants = stats.objets_vivants;
+    }
+    if (stats.octets_vivants > stats.pic_octets_vivants) {
+        stats.pic_octets_vivants = stats.octets_vivants;
+    }
+
+    if (taille > taille_bloc / 4) {
+        return nouveauBloc(taille);
+    }
+    size_t decalage = courant == nullptr ? 0 : (alignement - reinterpret_cast<size_t>(courant) % alignement) % alignement;
+    if (courant == nullptr || static_cast<size_t>(fin - courant) < decalage + taille) {
+        courant = nouveauBloc(taille_bloc);
+        fin = courant + taille_bloc;
+        decalage = 0;
+    }
+    void* p = courant + decalage;
+    courant += decalage + taille;
+    return p;
+}
+
+/**
+ * @brief Compte un objet détruit. Sa mémoire n'est reprise qu'avec l'arène.
+ * @param taille Taille de l'objet en octets.
+ */
+void ArenaSession::rendre(size_t taille) {
+    lock_guard<mutex> lock(mtx);
+    stats.objets_vivants--;
+    stats.octets_vivants -= taille;
+}
+
+/**
+ * @brief Retourne une copie des statistiques de l'arène.
+ * @return Les statistiques.
+ */
+ArenaSession::Statistiques ArenaSession::getStatistiques() const {
+    lock_guard<mutex> lock(mtx);
+    return stats;
+}
+
+/**
+ * @brief Affiche les statistiques de l'arène sur une ligne.
+ * @param nom Le nom de l'arène dans l'affichage.
+ */
+void ArenaSession::afficherStatistiques(const string& nom) const {
+    Statistiques s = getStatistiques();
+    cout << "Arene " << nom << ": " << s.objets << " objet(s), " << s.octets << " octet(s) demandes, pic "
+         << s.pic_octets_vivants << " octet(s) / " << s.pic_objets_vivants << " objet(s) vivants, "
+         << s.blocs << " bloc(s) (" << s.octets_reserves << " octets)" << endl;
+}
@@ -1,13 +1,24 @@
 /**
  * @file BoiteAuLettres.cpp
  * @brief Implementation de la classe BoiteAuLettres.
+ *
+ * Chaque boîte relie un acheteur et un vendeur, qui s'écrivent à tour de rôle. Tous les appels prenaient le
+ * même mutex, y compris les lectures répétées de dernierMessage pendant la négociation. La boîte a maintenant
+ * un anneau par sens, écrit par un seul thread : laisser un message est une écriture dans l'anneau suivie
+ * d'une publication atomique du compteur, lire le dernier message compare le dernier message de chaque sens.
+ *
+ * L'anneau n'est pas une file : il n'a pas d'indice de lecture et ne se vide jamais. C'est une fenêtre sur les
+ * CAPACITE_ANNEAU derniers messages d'un sens, où le plus ancien est écrasé ; un lecteur sait ce qu'il n'a pas
+ * encore lu en comparant getNbrMessages au nombre de messages qu'il a déjà traités, et lit dernierMessage.
+ * La négociation n'a besoin que du dernier message, l'anneau garde les précédents pour getMessage.
+ * La discussion complète (vue Chats, getMessage, getBoiteAuLettres) est gardée dans un historique en segments
+ * qui ne sont jamais déplacés, créé seulement si la boîte est construite avec l'historique.
  */
 
 #include <vector>
 #include <iostream>
 #include "Message.h"
 #include "BoiteAuLettres.h"
-#include <mutex>
 
 using namespace std ;
 
@@ -16,20 +27,32 @@ using namespace std ;
  * @brief Représente une boîte aux lettres contenant des messages.
  *
  * La classe gère l'ajout, l'affichage et la récupération de messages.
- * Elle assure également la sécurité des accès concurrents via un verrou mutex.
+ * Les accès concurrents se font sans verrou : chaque sens de la discussion n'a qu'un seul écrivain.
+ *
+ * @param prot Le protocole de la négociation.
+ * @param avec_historique True pour garder toute la discussion, false pour ne garder que les derniers messages.
  */
-BoiteAuLettres::BoiteAuLettres(shared_ptr<Protocol> prot){
-    this->boiteAuLettres = {};
+BoiteAuLettres::BoiteAuLettres(shared_ptr<Protocol> prot, bool avec_historique) : sequence(0), relances(0){
     this->protocol = prot;
+    if (avec_historique) {
+        historique.reset(new Historique());
+        for (atomic<Segment*>& s : *historique) {
+            s.store(nullptr, memory_order_relaxed);
+        }
+    }
 }
 
 /**
  * @brief Destructeur de la classe BoiteAuLettres.
  *
- * Le destructeur vide la boîte aux lettres.
+ * Le destructeur libère les segments de l'historique.
  */
 BoiteAuLettres::~BoiteAuLettres(){
-    boiteAuLettres.clear();
+    if (historique != nullptr) {
+        for (atomic<Segment*>& s : *historique) {
+            delete s.load(memory_order_relaxed);
+        }
+    }
 }
 
 /**
@@ -48,35 +71,94 @@ void BoiteAuLettres::setProtocol(shared_ptr<Protocol> prot){
     protocol = prot;
 }
 
+/**
+ * @brief Ajoute un message à l'historique, à son rang dans la discussion.
+ *
+ * Les deux émetteurs peuvent créer le même segment : un seul l'installe, l'autre rend le sien.
+ *
+ * @param rang Le rang du message.
+ * @param m Le message.
+ */
+void BoiteAuLettres::archiver(uint32_t rang, const Message& m){
+    if (rang / TAILLE_SEGMENT >= NBR_SEGMENTS_MAX) {
+        cerr << "BoiteAuLettres: historique plein, message " << rang << " non garde" << endl;
+        return;
+    }
+    atomic<Segment*>& emplacement = (*historique)[rang / TAILLE_SEGMENT];
+    Segment* segment = emplacement.load(memory_order_acquire);
+    if (segment == nullptr) {
+        Segment* nouveau = new Segment();
+        if (emplacement.compare_exchange_strong(segment, nouveau, memory_order_acq_rel)) {
+            segment = nouveau;
+        } else {
+            delete nouveau;
+        }
+    }
+    Entree& e = (*segment)[rang % TAILLE_SEGMENT];
+    e.message = m;
+    e.publie.store(true, memory_order_release);
+}
+
 /**
  * @brief Ajoute un message dans la boîte aux lettres.
  *
- * Cette méthode protège l'accès concurrent à la boîte aux lettres via un mutex.
- * @param m Le message à ajouter.
+ * Seul le thread de l'émetteur écrit dans l'anneau de son sens : le message est rangé, puis le compteur
+ * publié, sans verrou. Après CAPACITE_ANNEAU messages, chaque écriture écrase le plus ancien du sens.
+ * Le message reçoit son tour dans la discussion : une recherche ou une offre et sa réponse.
+ * @param m Le message à ajouter, copié dans la boîte.
+ * @param emetteur Le côté qui laisse le message.
  * @return La taille de la boîte aux lettres après l'ajout.
  */
-int BoiteAuLettres::laisserMessage(shared_ptr<Message> m){
-    lock_guard<std::mutex> guard(mtx);
-    boiteAuLettres.push_back(m);
-    return boiteAuLettres.size();
+int BoiteAuLettres::laisserMessage(Message m, Emetteur emetteur){
+    uint32_t rang = sequence.fetch_add(1, memory_order_relaxed);
+    m.setTour(static_cast<uint16_t>(rang / 2));
+    if (historique != nullptr) {
+        archiver(rang, m);
+    }
+
+    Anneau& a = anneaux[static_cast<size_t>(emetteur)];
+    uint32_t ecrits = a.ecrits.load(memory_order_relaxed);
+    a.messages[ecrits % CAPACITE_ANNEAU] = m;
+    a.sequences[ecrits % CAPACITE_ANNEAU] = rang;
+    a.ecrits.store(ecrits + 1, memory_order_release);
+    return rang + 1;
 }
 
 /**
  * @brief Récupère le dernier message de la boîte aux lettres.
  *
- * Si la boîte aux lettres est vide, affiche un message d'erreur et retourne un pointeur nul.
- * @return Le dernier message ou nullptr si la boîte est vide.
- */
-shared_ptr<Message> BoiteAuLettres::dernierMessage(){
-    lock_guard<std::mutex> guard(mtx);
-    int index = boiteAuLettres.size();
-    if(index == 0){
-        cout << "Boite au lettres vide!" << endl;
-        return nullptr;
-    } else {
-        index--;
-        return boiteAuLettres[index];
+ * Le plus récent des derniers messages des deux sens.
+ * Si la boîte aux lettres est vide, affiche un message d'erreur et retourne un message vide.
+ * @return Le dernier message, vide (Message::estVide) si la boîte est vide.
+ */
+Message BoiteAuLettres::dernierMessage() const{
+    const Anneau* dernier = nullptr;
+    uint32_t position = 0;
+    for (const Anneau& a : anneaux) {
+        uint32_t ecrits = a.ecrits.load(memory_order_acquire);
+        if (ecrits == 0) {
+            continue;
+        }
+        uint32_t p = (ecrits - 1) % CAPACITE_ANNEAU;
+        if (dernier == nullptr || a.sequences[p] > dernier->sequences[position]) {
+            dernier = &a;
+            position = p;
+        }
     }
+    if(dernier == nullptr){
+        return Message(); //Boite vide, cas normal avant le premier message
+    }
+    return dernier->messages[position];
+}
+
+/**
+ * @brief Compte un réveil du vendeur sans message de l'acheteur.
+ *
+ * L'acheteur qui n'a rien à répondre à une offre réveille quand même le vendeur, qui relit alors sa propre
+ * offre. Un vendeur qui négocie avec plusieurs acheteurs sait ainsi quelle discussion relire.
+ */
+void BoiteAuLettres::relancer(){
+    relances.fetch_add(1, memory_order_release);
 }
 
 /**
@@ -85,10 +167,8 @@ shared_ptr<Message> BoiteAuLettres::dernierMessage(){
  * Chaque message est affiché dans l'ordre d'ajout.
  */
 void BoiteAuLettres::afficherDiscussion(){
-    lock_guard<std::mutex> guard(mtx);
-    int index = boiteAuLettres.size();
-    for (int i = 0; i < index; i++){
-        boiteAuLettres[i]->afficherMessage();
+    for (const Message& m : getBoiteAuLettres()){
+        m.afficherMessage();
     }
 }
 
@@ -96,34 +176,83 @@ void BoiteAuLettres::afficherDiscussion(){
  * @brief Vérifie si la boîte aux lettres est vide.
  * @return True si la boîte aux lettres est vide, sinon False.
  */
-bool BoiteAuLettres::estVide(){
-    lock_guard<std::mutex> guard(mtx);
-    return boiteAuLettres.empty();
+bool BoiteAuLettres::estVide() const{
+    return getSize() == 0;
 }
 
 /**
  * @brief Récupère la taille actuelle de la boîte aux lettres.
- * @return La taille de la boîte aux lettres.
+ * @return Le nombre de messages laissés depuis la création, tous sens confondus.
  */
-int BoiteAuLettres::getSize(){
-    lock_guard<std::mutex> guard(mtx);
-    return boiteAuLettres.size();
+int BoiteAuLettres::getSize() const{
+    return anneaux[0].ecrits.load(memory_order_acquire) + anneaux[1].ecrits.load(memory_order_acquire);
+}
+
+/**
+ * @brief Récupère le nombre de messages laissés par un côté de la discussion.
+ * @param emetteur Le côté.
+ * @return Le nombre de messages laissés par ce côté depuis la création.
+ */
+int BoiteAuLettres::getNbrMessages(Emetteur emetteur) const{
+    return anneaux[static_cast<size_t>(emetteur)].ecrits.load(memory_order_acquire);
+}
+
+/**
+ * @brief Récupère le nombre de réveils du vendeur sans message de l'acheteur.
+ * @return Le nombre de relances depuis la création.
+ */
+int BoiteAuLettres::getNbrRelances() const{
+    return relances.load(memory_order_acquire);
 }
 
 /**
  * @brief Récupère un message par son index.
+ *
+ * Sans historique, seuls les messages encore dans les anneaux sont trouvés.
  * @param i L'index du message à récupérer.
- * @return Le message à l'index spécifié.
+ * @return Le message à l'index spécifié, vide s'il n'existe pas ou n'est plus gardé.
  */
-shared_ptr<Message> BoiteAuLettres::getMessage(int i){
-    lock_guard<std::mutex> guard(mtx);
-    return boiteAuLettres[i];
+Message BoiteAuLettres::getMessage(int i) const{
+    if (i < 0) {
+        return Message();
+    }
+    uint32_t rang = static_cast<uint32_t>(i);
+    if (historique != nullptr) {
+        if (rang / TAILLE_SEGMENT >= NBR_SEGMENTS_MAX) {
+            return Message();
+        }
+        const Segment* segment = (*historique)[rang / TAILLE_SEGMENT].load(memory_order_acquire);
+        if (segment == nullptr) {
+            return Message();
+        }
+        const Entree& e = (*segment)[rang % TAILLE_SEGMENT];
+        return e.publie.load(memory_order_acquire) ? e.message : Message();
+    }
+    for (const Anneau& a : anneaux) {
+        uint32_t ecrits = a.ecrits.load(memory_order_acquire);
+        uint32_t debut = ecrits > CAPACITE_ANNEAU ? ecrits - CAPACITE_ANNEAU : 0;
+        for (uint32_t n = debut; n < ecrits; n++) {
+            if (a.sequences[n % CAPACITE_ANNEAU] == rang) {
+                return a.messages[n % CAPACITE_ANNEAU];
+            }
+        }
+    }
+    return Message();
 }
 
 /**
  * @brief Récupère tous les messages de la boîte aux lettres.
- * @return Un vecteur de tous les messages dans la boîte aux lettres.
+ * @return Un vecteur des messages encore gardés, dans l'ordre d'ajout.
  */
-vector<shared_ptr<Message>> BoiteAuLettres::getBoiteAuLettres() const {
-    return boiteAuLettres;
+vector<Message> BoiteAuLettres::getBoiteAuLettres() const {
+    int taille = getSize();
+    vector<Message> messages;
+    messages.reserve(taille);
+    for (int i = 0; i < taille; i++) {
+        Message m = getMessage(i);
+        if (!m.estVide()) {
+            messages.push_back(m);
+        }
+    }
+    return messages;
 }
@@ -0,0 +1,353 @@
+/**
+ * @file Catalogue.cpp
+ * @brief Implémentation de la classe Catalogue, accès indexé aux fichiers CSV des voitures.
+ *
+ * Les neuf fichiers de data/ sont projetés une seule fois en mémoire et un index des débuts de lignes est
+ * construit pour chacun. N'importe quelle ligne est ensuite accessible en O(1), sans relire le fichier.
+ */
+
+#include "Catalogue.h"
+#include "InstantaneCatalogue.h"
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <cstring>
+
+using namespace std;
+
+const string Catalogue::DOSSIER_DATA_DEFAUT = "../../data/";
+
+namespace {
+
+struct FichierMarque {
+    const char* fichier;
+    const char* marque;
+};
+
+// Ordre des categories utilisé par vendeur_Initialisation
+const FichierMarque FICHIERS_MARQUES[] = {
+    {"audi.csv", "Audi"},
+    {"bmw.csv", "BMW"},
+    {"ford.csv", "Ford"},
+    {"hyundi.csv", "Hyundai"},
+    {"merc.csv", "Mercedes"},
+    {"skoda.csv", "Skoda"},
+    {"toyota.csv", "Toyota"},
+    {"vauxhall.csv", "Vauxhall"},
+    {"vw.csv", "VW"},
+};
+
+}
+
+/**
+ * @brief Constructeur privé, le catalogue est un singleton.
+ */
+Catalogue::Catalogue() : charge(false), depuis_instantane(false), progression(0), termine(false) {}
+
+/**
+ * @brief Destructeur, les projections mémoire sont libérées avec les fichiers.
+ *
+ * Un préchargement encore en cours est attendu par la destruction de son future.
+ */
+Catalogue::~Catalogue() {}
+
+/**
+ * @brief Retourne l'instance unique du catalogue.
+ * @return Le catalogue partagé par toute l'application.
+ */
+Catalogue& Catalogue::getInstance() {
+    static Catalogue instance;
+    return instance;
+}
+
+/**
+ * @brief Projette un fichier en mémoire et construit l'index de ses lignes.
+ * @param f Le fichier à projeter.
+ * @return True si le fichier a pu être projeté.
+ */
+bool Catalogue::projeter(FichierProjete& f) {
+    f.lignes.clear();
+    if (!f.projection.ouvrir(f.chemin)) {
+        return false;
+    }
+
+    // Index des débuts de lignes
+    const char* debut = f.projection.getDebut();
+    size_t taille = f.projection.getTaille();
+    if (taille > 0) {
+        f.lignes.push_back(0);
+    }
+    const char* fin = debut + taille;
+    const char* p = debut;
+    while ((p = static_cast<const char*>(memchr(p, '\n', fin - p))) != nullptr && ++p < fin) {
+        f.lignes.push_back(static_cast<uint32_t>(p - debut));
+    }
+    return true;
+}
+
+/**
+ * @brief Remplit le catalogue en colonnes, depuis l'instantané binaire s'il est à jour.
+ *
+ * Sinon les fichiers CSV sont décodés et l'instantané est régénéré pour le prochain lancement.
+ * @param dossier Le dossier contenant les fichiers CSV et l'instantané.
+ */
+void Catalogue::chargerColonnes(const string& dossier) {
+    vector<EtatSource> sources(fichiers.size());
+    for (size_t i = 0; i < fichiers.size(); i++) {
+        sources[i].taille = fichiers[i].projection.getTaille();
+        sources[i].donnees = fichiers[i].projection.getDebut();
+        std::error_code erreur;
+        auto date = filesystem::last_write_time(fichiers[i].chemin, erreur);
+        if (!erreur) {
+            sources[i].date_modif = chrono::duration_cast<chrono::nanoseconds>(date.time_since_epoch()).count();
+        }
+    }
+
+    string chemin_instantane = dossier + InstantaneCatalogue::NOM_FICHIER;
+    bool dates_changees = false;
+    depuis_instantane = InstantaneCatalogue::lire(chemin_instantane, colonnes, sources, dates_changees);
+    if (depuis_instantane && !dates_changees) {
+        return;
+    }
+    if (!depuis_instantane) {
+        colonnes.construire(*this, 0, [this](size_t faits, size_t total) {
+            progression = 10 + static_cast<int>(85 * faits / total);
+        });
+    }
+    if (!InstantaneCatalogue::ecrire(chemin_instantane, colonnes, sources)) {
+        cerr << "Catalogue: impossible d'ecrire " << chemin_instantane << endl;
+    }
+}
+
+/**
+ * @brief Projette les neuf fichiers de marques et construit leurs index.
+ *
+ * Un fichier introuvable est signalé et reste vide, les autres restent utilisables.
+ * Les colonnes sont ensuite lues depuis l'instantané binaire, ou décodées depuis les CSV s'il est périmé.
+ * Un second appel après un chargement réussi ne fait rien.
+ * @param dossier Le dossier contenant les fichiers CSV.
+ * @return True si au moins un fichier a été chargé.
+ */
+bool Catalogue::charger(const string& dossier) {
+    lock_guard<std::mutex> guard(mtx);
+    if (charge) {
+        return true;
+    }
+
+    termine = false;
+    progression = 0;
+    bool au_moins_un = false;
+    fichiers.clear();
+    fichiers.resize(sizeof(FICHIERS_MARQUES) / sizeof(FICHIERS_MARQUES[0]));
+    for (size_t i = 0; i < fichiers.size(); i++) {
+        fichiers[i].chemin = dossier + FICHIERS_MARQUES[i].fichier;
+        fichiers[i].marque = FICHIERS_MARQUES[i].marque;
+        if (projeter(fichiers[i])) {
+            au_moins_un = au_moins_un || fichiers[i].lignes.size() > 1;
+        } else {
+            cerr << "Catalogue: impossible d'ouvrir " << fichiers[i].chemin << endl;
+        }
+    }
+    progression = 10;
+    if (au_moins_un) {
+        chargerColonnes(dossier);
+        colonnes.preparerChaines();
+    }
+    charge = au_moins_un;
+    progression = 100;
+    termine = true;
+    return charge;
+}
+
+/**
+ * @brief Lance le chargement du catalogue dans un thread, sans attendre sa fin.
+ *
+ * Appelée au lancement de l'application, pendant l'affichage de l'écran de démarrage. Les appels suivants à
+ * charger (par exemple depuis vendeur_Initialisation) attendent la fin de ce chargement puis retournent
+ * immédiatement. Un second appel à precharger ne fait rien.
+ * @param dossier Le dossier contenant les fichiers CSV.
+ */
+void Catalogue::precharger(const string& dossier) {
+    lock_guard<std::mutex> guard(mtx);
+    if (charge || prechargement.valid()) {
+        return;
+    }
+    prechargement = async(launch::async, [this, dossier]() { return charger(dossier); });
+}
+
+/**
+ * @brief Indique si le dernier chargement est terminé, sans attendre.
+ * @return True si le chargement est terminé, qu'il ait réussi ou non.
+ */
+bool Catalogue::estTermine() const {
+    return termine;
+}
+
+/**
+ * @brief Récupère l'avancement du chargement en cours, sans attendre.
+ * @return Le pourcentage effectué, de 0 à 100.
+ */
+int Catalogue::getProgression() const {
+    return progression;
+}
+
+/**
+ * @brief Indique si le catalogue a été chargé.
+ * @return True si le catalogue est chargé.
+ */
+bool Catalogue::estCharge() const {
+    lock_guard<std::mutex> guard(mtx);
+    return charge;
+}
+
+/**
+ * @brief Indique si les colonnes ont été lues depuis l'instantané binaire.
+ * @return True si aucun fichier CSV n'a eu besoin d'être décodé.
+ */
+bool Catalogue::estDepuisInstantane() const {
+    lock_guard<std::mutex> guard(mtx);
+    return depuis_instantane;
+}
+
+/**
+ * @brief Récupère le nombre de marques (catégories) du catalogue.
+ * @return Le nombre de fichiers de marques.
+ */
+int Catalogue::getNbrMarques() const {
+    return static_cast<int>(fichiers.size());
+}
+
+/**
+ * @brief Récupère le nom de la marque d'une catégorie.
+ * @param cat L'indice de la catégorie.
+ * @return Le nom de la marque.
+ */
+string Catalogue::getMarque(int cat) const {
+    return fichiers[cat].marque;
+}
+
+/**
+ * @brief Récupère le chemin du fichier d'une catégorie.
+ * @param cat L'indice de la catégorie.
+ * @return Le chemin du fichier CSV.
+ */
+string Catalogue::getChemin(int cat) const {
+    return fichiers[cat].chemin;
+}
+
+/**
+ * @brief Récupère le nombre de lignes de données d'une catégorie.
+ * @param cat L'indice de la catégorie.
+ * @return Le nombre de lignes, en-tête exclu.
+ */
+int Catalogue::getNbrLignes(int cat) const {
+    const auto& lignes = fichiers[cat].lignes;
+    return lignes.empty() ? 0 : static_cast<int>(lignes.size()) - 1;
+}
+
+/**
+ * @brief Récupère une ligne du fichier par son numéro, sans fin de ligne.
+ * @param cat L'indice de la catégorie.
+ * @param numero Le numéro de la ligne dans le fichier (0 = en-tête).
+ * @return La ligne, vide si elle n'existe pas.
+ */
+string_view Catalogue::ligneFichier(int cat, int numero) const {
+    if (cat < 0 || cat >= static_cast<int>(fichiers.size())) {
+        return {};
+    }
+    const FichierProjete& f = fichiers[cat];
+    if (numero < 0 || numero >= static_cast<int>(f.lignes.size())) {
+        return {};
+    }
+    const char* donnees = f.projection.getDebut();
+    size_t debut = f.lignes[numero];
+    size_t fin = (numero + 1 < static_cast<int>(f.lignes.size())) ? f.lignes[numero + 1] : f.projection.getTaille();
+    while (fin > debut && (donnees[fin - 1] == '\n' || donnees[fin - 1] == '\r')) {
+        fin--;
+    }
+    return string_view(donnees + debut, fin - debut);
+}
+
+/**
+ * @brief Récupère une ligne de données en O(1).
+ * @param cat L'indice de la catégorie.
+ * @param ligne L'indice de la ligne de données (0 = première voiture).
+ * @return La ligne, vide si elle n'existe pas.
+ */
+string_view Catalogue::getLigne(int cat, int ligne) const {
+    return ligneFichier(cat, ligne + 1);
+}
+
+/**
+ * @brief Récupère une ligne de données découpée en champs.
+ * @param cat L'indice de la catégorie.
+ * @param ligne L'indice de la ligne de données.
+ * @return Les champs de la ligne.
+ */
+vector<string> Catalogue::getChamps(int cat, int ligne) const {
+    return getChampsFichier(cat, ligne + 1);
+}
+
+/**
+ * @brief Récupère une ligne du fichier découpée en champs.
+ * @param cat L'indice de la catégorie.
+ * @param numero Le numéro de la ligne dans le fichier (0 = en-tête).
+ * @return Les champs de la ligne, vide si elle n'existe pas.
+ */
+vector<string> Catalogue::getChampsFichier(int cat, int numero) const {
+    string_view ligne = ligneFichier(cat, numero);
+    vector<string> champs;
+    if (ligne.empty()) {
+        return champs;
+    }
+    size_t debut = 0;
+    while (true) {
+        size_t virgule = ligne.find(',', debut);
+        if (virgule == string_view::npos) {
+            champs.emplace_back(ligne.substr(debut));
+            break;
+        }
+        champs.emplace_back(ligne.substr(debut, virgule - debut));
+        debut = virgule + 1;
+    }
+    return champs;
+}
+
+/**
+ * @brief Récupère le contenu complet du fichier d'une catégorie.
+ * @param cat L'indice de la catégorie.
+ * @return Le contenu projeté, vide si la catégorie n'existe pas.
+ */
+string_view Catalogue::getContenu(int cat) const {
+    if (cat < 0 || cat >= static_cast<int>(fichiers.size())) {
+        return {};
+    }
+    const ProjectionFichier& projection = fichiers[cat].projection;
+    return string_view(projection.getDebut(), projection.getTaille());
+}
+
+/**
+ * @brief Retrouve la catégorie correspondant à un chemin de fichier.
+ *
+ * La comparaison se fait sur le nom du fichier, le dossier peut donc être écrit différemment.
+ * @param chemin Le chemin du fichier CSV.
+ * @return L'indice de la catégorie, ou -1 si le fichier n'est pas chargé.
+ */
+int Catalogue::trouverCategorie(const string& chemin) const {
+    size_t slash = chemin.find_last_of("/\\");
+    string nom = (slash == string::npos) ? chemin : chemin.substr(slash + 1);
+    for (size_t i = 0; i < fichiers.size(); i++) {
+        if (nom == FICHIERS_MARQUES[i].fichier && !fichiers[i].lignes.empty()) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Récupère le catalogue décodé en colonnes.
+ * @return Les colonnes du catalogue.
+ */
+const CatalogueColonnes& Catalogue::getColonnes() const {
+    return colonnes;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file CatalogueColonnes.cpp
+ * @brief Implémentation de la classe CatalogueColonnes, stockage en colonnes de toutes les voitures du catalogue.
+ *
+ * Chaque attribut est rangé dans un tableau contigu (une case par ligne du catalogue). Les attributs textuels
+ * (marque, modèle, boîte de vitesses, carburant) sont encodés par dictionnaire. Les vendeurs référencent les
+ * lignes par leur indice, ce qui permet de filtrer et d'agréger en parcourant des tableaux plutôt que des objets.
+ */
+
+#include "CatalogueColonnes.h"
+#include "Catalogue.h"
+#include "AnalyseurCSV.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+// Morceau de fichier décodé avec ses propres colonnes et dictionnaires, avant fusion
+struct CatalogueColonnes::Morceau {
+    int cat;
+    string_view contenu;
+    const AnalyseurCSV* en_tete;
+    CatalogueColonnes colonnes;
+};
+
+/**
+ * @brief Constructeur d'un catalogue en colonnes vide.
+ */
+CatalogueColonnes::CatalogueColonnes() {}
+
+/**
+ * @brief Vide toutes les colonnes et tous les dictionnaires.
+ */
+void CatalogueColonnes::vider() {
+    annees.clear();
+    prix.clear();
+    kilometres.clear();
+    taxes.clear();
+    mpgs.clear();
+    tailles_engin.clear();
+    marques.clear();
+    modeles.clear();
+    boites.clear();
+    essences.clear();
+    dico_marques.vider();
+    dico_modeles.vider();
+    dico_boites.vider();
+    dico_essences.vider();
+    debut_marques.clear();
+}
+
+/**
+ * @brief Interne les valeurs des quatre dictionnaires dans la table globale des chaînes.
+ *
+ * Les voitures créées depuis le catalogue reçoivent alors directement leurs identifiants, et les critères de
+ * recherche sont traduits en codes sans comparer de chaînes.
+ */
+void CatalogueColonnes::preparerChaines() {
+    dico_marques.internerValeurs();
+    dico_modeles.internerValeurs();
+    dico_boites.internerValeurs();
+    dico_essences.internerValeurs();
+}
+
+/**
+ * @brief Découpe le contenu d'un fichier en morceaux de lignes complètes.
+ * @param cat L'indice de la catégorie du fichier.
+ * @param donnees Les lignes de données du fichier, sans l'en-tête.
+ * @param en_tete L'analyseur qui a lu l'en-tête du fichier.
+ * @param morceaux Les morceaux, complétés dans l'ordre du fichier.
+ */
+void CatalogueColonnes::decouper(int cat, string_view donnees, const AnalyseurCSV* en_tete, vector<Morceau>& morceaux) {
+    size_t debut = 0;
+    while (debut < donnees.size()) {
+        size_t fin = donnees.size();
+        if (fin - debut > TAILLE_MORCEAU) {
+            size_t retour = donnees.find('\n', debut + TAILLE_MORCEAU - 1);
+            fin = (retour == string_view::npos) ? donnees.size() : retour + 1;
+        }
+        Morceau m;
+        m.cat = cat;
+        m.contenu = donnees.substr(debut, fin - debut);
+        m.en_tete = en_tete;
+        morceaux.push_back(move(m));
+        debut = fin;
+    }
+}
+
+/**
+ * @brief Décode un morceau de fichier dans ses propres colonnes et dictionnaires.
+ *
+ * Appelée en parallèle sur des morceaux différents, elle ne touche à aucune donnée partagée.
+ * @param m Le morceau à décoder.
+ */
+void CatalogueColonnes::analyser(Morceau& m) {
+    AnalyseurCSV analyseur(m.contenu);
+    analyseur.utiliserEnTete(*m.en_tete);
+    LigneCSV ligne;
+    while (analyseur.suivante(ligne)) {
+        if (!ligne.valide) {
+            continue;   // Ligne incomplète ou illisible, ignorée
+        }
+        m.colonnes.annees.push_back(ligne.annee);
+        m.colonnes.prix.push_back(ligne.prix);
+        m.colonnes.kilometres.push_back(ligne.kilometres);
+        m.colonnes.taxes.push_back(ligne.taxe);
+        m.colonnes.mpgs.push_back(ligne.mpg);
+        m.colonnes.tailles_engin.push_back(ligne.taille_engin);
+        m.colonnes.modeles.push_back(m.colonnes.dico_modeles.encoder(ligne.modele));
+        m.colonnes.boites.push_back(m.colonnes.dico_boites.encoder(ligne.boite));
+        m.colonnes.essences.push_back(m.colonnes.dico_essences.encoder(ligne.essence));
+    }
+}
+
+/**
+ * @brief Ajoute un morceau décodé à la fin des colonnes, en traduisant ses codes dans les dictionnaires globaux.
+ *
+ * Les morceaux étant ajoutés dans l'ordre des fichiers, les codes obtenus sont les mêmes qu'avec un décodage
+ * séquentiel, quel que soit le nombre de threads.
+ * @param m Le morceau décodé.
+ * @param code_marque Le code de la marque du morceau.
+ */
+void CatalogueColonnes::fusionner(const Morceau& m, CodeDico code_marque) {
+    auto traduire = [](const Dictionnaire& local, Dictionnaire& global, const vector<CodeDico>& source,
+                       vector<CodeDico>& destination) {
+        vector<CodeDico> table(local.getTaille());
+        for (size_t c = 0; c < table.size(); c++) {
+            table[c] = global.encoder(local.decoder(static_cast<CodeDico>(c)));
+        }
+        for (CodeDico c : source) {
+            destination.push_back(table[c]);
+        }
+    };
+
+    const CatalogueColonnes& c = m.colonnes;
+    annees.insert(annees.end(), c.annees.begin(), c.annees.end());
+    prix.insert(prix.end(), c.prix.begin(), c.prix.end());
+    kilometres.insert(kilometres.end(), c.kilometres.begin(), c.kilometres.end());
+    taxes.insert(taxes.end(), c.taxes.begin(), c.taxes.end());
+    mpgs.insert(mpgs.end(), c.mpgs.begin(), c.mpgs.end());
+    tailles_engin.insert(tailles_engin.end(), c.tailles_engin.begin(), c.tailles_engin.end());
+    marques.insert(marques.end(), c.annees.size(), code_marque);
+    traduire(c.dico_modeles, dico_modeles, c.modeles, modeles);
+    traduire(c.dico_boites, dico_boites, c.boites, boites);
+    traduire(c.dico_essences, dico_essences, c.essences, essences);
+}
+
+/**
+ * @brief Décode toutes les lignes des fichiers du catalogue dans les colonnes.
+ *
+ * Chaque fichier est découpé en morceaux de lignes complètes (un seul pour les petits fichiers), décodés en
+ * parallèle par un groupe de threads, puis fusionnés dans l'ordre. Les colonnes sont repérées par leur nom dans
+ * l'en-tête. Les lignes incomplètes ou illisibles sont ignorées. Les marques sont encodées dans l'ordre des
+ * catégories, le code d'une marque est donc égal à l'indice de sa catégorie.
+ * @param catalogue Le catalogue des fichiers CSV projetés.
+ * @param nbr_threads Le nombre de threads de décodage, 0 pour un par cœur.
+ * @param progression Appelée après chaque morceau décodé, depuis le thread qui l'a décodé.
+ */
+void CatalogueColonnes::construire(const Catalogue& catalogue, unsigned nbr_threads,
+                                   const function<void(size_t faits, size_t total)>& progression) {
+    vider();
+
+    // En-têtes lus séquentiellement, ils sont courts
+    vector<AnalyseurCSV> en_tetes;
+    en_tetes.reserve(catalogue.getNbrMarques());
+    vector<Morceau> morceaux;
+    for (int cat = 0; cat < catalogue.getNbrMarques(); cat++) {
+        string_view contenu = catalogue.getContenu(cat);
+        en_tetes.emplace_back(contenu);
+        if (!en_tetes.back().lireEnTete()) {
+            if (!contenu.empty()) {
+                cerr << "Catalogue: en-tete non reconnu dans " << catalogue.getChemin(cat) << endl;
+            }
+            continue;
+        }
+        decouper(cat, contenu.substr(en_tetes.back().getPosition()), &en_tetes.back(), morceaux);
+    }
+
+    // Décodage des morceaux, chaque thread prend le suivant disponible
+    if (nbr_threads == 0) {
+        nbr_threads = max(1u, thread::hardware_concurrency());
+    }
+    nbr_threads = static_cast<unsigned>(min<size_t>(nbr_threads, morceaux.size()));
+    atomic<size_t> suivant(0);
+    atomic<size_t> faits(0);
+    auto travailleur = [&]() {
+        size_t i;
+        while ((i = suivant.fetch_add(1)) < morceaux.size()) {
+            analyser(morceaux[i]);
+            size_t total_faits = faits.fetch_add(1) + 1;
+            if (progression) {
+                progression(total_faits, morceaux.size());
+            }
+        }
+    };
+    vector<thread> threads;
+    for (unsigned t = 1; t < nbr_threads; t++) {
+        threads.emplace_back(travailleur);
+    }
+    travailleur();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Fusion dans l'ordre des fichiers
+    size_t total = 0;
+    for (const Morceau& m : morceaux) {
+        total += m.colonnes.annees.size();
+    }
+    annees.reserve(total);
+    prix.reserve(total);
+    kilometres.reserve(total);
+    taxes.reserve(total);
+    mpgs.reserve(total);
+    tailles_engin.reserve(total);
+    marques.reserve(total);
+    modeles.reserve(total);
+    boites.reserve(total);
+    essences.reserve(total);
+
+    size_t m = 0;
+    for (int cat = 0; cat < catalogue.getNbrMarques(); cat++) {
+        CodeDico code_marque = dico_marques.encoder(catalogue.getMarque(cat));
+        debut_marques.push_back(static_cast<uint32_t>(annees.size()));
+        for (; m < morceaux.size() && morceaux[m].cat == cat; m++) {
+            fusionner(morceaux[m], code_marque);
+        }
+    }
+    debut_marques.push_back(static_cast<uint32_t>(annees.size()));
+}
+
+/**
+ * @brief Récupère le nombre total de lignes du catalogue.
+ * @return Le nombre de voitures.
+ */
+size_t CatalogueColonnes::getNbrLignes() const {
+    return annees.size();
+}
+
+/**
+ * @brief Récupère le nombre de marques.
+ * @return Le nombre de catégories.
+ */
+int CatalogueColonnes::getNbrMarques() const {
+    return debut_marques.empty() ? 0 : static_cast<int>(debut_marques.size()) - 1;
+}
+
+/**
+ * @brief Récupère la première ligne d'une marque.
+ * @param cat L'indice de la catégorie.
+ * @return L'indice de la première ligne de la marque.
+ */
+uint32_t CatalogueColonnes::getDebutMarque(int cat) const {
+    return debut_marques[cat];
+}
+
+/**
+ * @brief Récupère le nombre de lignes d'une marque.
+ * @param cat L'indice de la catégorie.
+ * @return Le nombre de voitures de la marque.
+ */
+uint32_t CatalogueColonnes::getNbrLignesMarque(int cat) const {
+    return debut_marques[cat + 1] - debut_marques[cat];
+}
+
+/**
+ * @brief Traduit une voiture partiellement renseignée en critère sur les codes des colonnes.
+ *
+ * Les chaînes vides et les valeurs numériques nulles signifient "peu importe", comme dans Vendeur::chercherProduit.
+ * @param v La voiture recherchée.
+ * @return Le critère équivalent.
+ */
+CritereColonnes CatalogueColonnes::traduireCritere(const Voiture& v) const {
+    CritereColonnes c;
+    //Interne une seule fois : la comparaison des identifiants ne prend pas le verrou de TableChaines
+    static const IdChaine voiture = TableChaines::getInstance().interner("Voiture");
+    if (v.getIdCategorie() != TableChaines::VIDE && v.getIdCategorie() != voiture) {
+        c.impossible = true;
+    }
+    if (v.getIdBrand() != TableChaines::VIDE) {
+        c.marque = dico_marques.chercherId(v.getIdBrand());
+        c.impossible = c.impossible || c.marque < 0;
+    }
+    if (v.getIdModel() != TableChaines::VIDE) {
+        c.modele = dico_modeles.chercherId(v.getIdModel());
+        c.impossible = c.impossible || c.modele < 0;
+    }
+    if (v.getIdBoiteDeVitesse() != TableChaines::VIDE) {
+        c.boite = dico_boites.chercherId(v.getIdBoiteDeVitesse());
+        c.impossible = c.impossible || c.boite < 0;
+    }
+    if (v.getIdEssence() != TableChaines::VIDE) {
+        c.essence = dico_essences.chercherId(v.getIdEssence());
+        c.impossible = c.impossible || c.essence < 0;
+    }
+    c.annee_min = v.getYear();
+    c.kilometres_max = v.getKilometres();
+    c.mpg_min = v.getMPG();
+    c.taille_engin_min = v.getTailleEngin();
+    return c;
+}
+
+/**
+ * @brief Vérifie si une ligne du catalogue satisfait un critère.
+ * @param ligne L'indice de la ligne.
+ * @param c Le critère traduit par traduireCritere.
+ * @return True si la ligne correspond.
+ */
+bool CatalogueColonnes::correspond(uint32_t ligne, const CritereColonnes& c) const {
+    return !c.impossible
+        && (c.marque < 0 || marques[ligne] == c.marque)
+        && (c.modele < 0 || modeles[ligne] == c.modele)
+        && annees[ligne] >= c.annee_min
+        && (c.boite < 0 || boites[ligne] == c.boite)
+        && (c.kilometres_max == 0 || kilometres[ligne] <= c.kilometres_max)
+        && (c.essence < 0 || essences[ligne] == c.essence)
+        && (c.mpg_min == 0 || mpgs[ligne] >= c.mpg_min)
+        && (c.taille_engin_min == 0 || tailles_engin[ligne] >= c.taille_engin_min);
+}
+
+/**
+ * @brief Construit une voiture à partir d'une ligne du catalogue.
+ * @param ligne L'indice de la ligne.
+ * @param id L'identifiant à donner à la voiture.
+ * @return La voiture correspondante.
+ */
+Voiture CatalogueColonnes::creerVoiture(uint32_t ligne, int id) const {
+    return Voiture(id, "pas de description", prix[ligne], "Voiture", "pas d'image",
+                   dico_marques.getIdChaine(marques[ligne]), dico_modeles.getIdChaine(modeles[ligne]), annees[ligne],
+                   dico_boites.getIdChaine(boites[ligne]), kilometres[ligne], dico_essences.getIdChaine(essences[ligne]),
+                   mpgs[ligne], tailles_engin[ligne]);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file CollecteOffres.cpp
+ * @brief Implémentation de la classe CollecteOffres, compte à rebours des réponses à une recherche.
+ *
+ * La recherche d'un acheteur passait d'un vendeur candidat au suivant, et seul le dernier réveillait l'acheteur :
+ * V candidats répondaient l'un après l'autre, en V passages de main. L'acheteur signale maintenant tous ses
+ * candidats en même temps, et chacun dépose sa réponse dans la collecte de l'acheteur au lieu de le réveiller.
+ *
+ * La collecte se ferme à la dernière réponse, dès que le seuil d'offres est atteint, ou à l'expiration du délai
+ * de recherche ; elle réveille alors l'acheteur, une seule fois. Les vendeurs qui répondent après la fermeture
+ * ne sont pas lus : le dépôt leur est refusé et ils terminent eux-mêmes la discussion.
+ */
+
+#include <algorithm>
+#include "CollecteOffres.h"
+
+using namespace std;
+
+/**
+ * @brief Constructeur, la collecte est fermée tant qu'elle n'a pas été ouverte.
+ */
+CollecteOffres::CollecteOffres() : attendues(0), offres(0), seuil(0), ouverte(false), reveil(nullptr) {}
+
+/**
+ * @brief Ouvre la collecte d'une nouvelle recherche.
+ *
+ * À appeler avant de signaler les candidats : un vendeur peut répondre dès qu'il est signalé.
+ *
+ * @param nbr_reponses Le nombre de candidats contactés.
+ * @param nbr_offres_suffisantes Le nombre d'offres après lequel l'acheteur n'attend plus, 0 pour toutes les réponses.
+ * @param evenement L'événement de l'acheteur, signalé à la fermeture.
+ */
+void CollecteOffres::ouvrir(int nbr_reponses, int nbr_offres_suffisantes, Evenement* evenement) {
+    lock_guard<mutex> lock(mtx);
+    attendues = nbr_reponses;
+    offres = 0;
+    seuil = nbr_offres_suffisantes;
+    reveil = evenement;
+    repondants.clear();
+    ouverte = true;
+    if (attendues <= 0) {
+        fermer();
+    }
+}
+
+/**
+ * @brief Ferme la collecte et réveille l'acheteur.
+ */
+void CollecteOffres::fermer() {
+    ouverte = false;
+    reveil->signaler();
+}
+
+/**
+ * @brief Dépose la réponse d'un vendeur.
+ * @param id_vendeur L'indice du vendeur.
+ * @param offre True si la réponse est une offre, false pour un break-down.
+ * @return True si la réponse sera lue par l'acheteur, false si la collecte était déjà fermée.
+ */
+bool CollecteOffres::deposer(int id_vendeur, bool offre) {
+    lock_guard<mutex> lock(mtx);
+    if (!ouverte) {
+        return false;
+    }
+    repondants.push_back(id_vendeur);
+    attendues--;
+    if (offre) {
+        offres++;
+    }
+    if (attendues <= 0 || (seuil > 0 && offres >= seuil)) {
+        fermer();
+    }
+    return true;
+}
+
+/**
+ * @brief Ferme la collecte à l'expiration du délai de recherche, si elle est encore ouverte.
+ */
+void CollecteOffres::expirer() {
+    lock_guard<mutex> lock(mtx);
+    if (ouverte) {
+        fermer();
+    }
+}
+
+/**
+ * @brief Retourne les vendeurs dont la réponse est arrivée avant la fermeture.
+ * @return Leurs indices, par ordre croissant comme les candidats.
+ */
+vector<int> CollecteOffres::getRepondants() {
+    lock_guard<mutex> lock(mtx);
+    vector<int> resultat = repondants;
+    sort(resultat.begin(), resultat.end());
+    return resultat;
+}
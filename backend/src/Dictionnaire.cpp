@@ -0,0 +1,103 @@
+/**
+ * @file Dictionnaire.cpp
+ * @brief Implémentation de la classe Dictionnaire, encodage des chaînes répétées en petits codes entiers.
+ */
+
+#include "Dictionnaire.h"
+
+using namespace std;
+
+/**
+ * @brief Constructeur d'un dictionnaire vide.
+ */
+Dictionnaire::Dictionnaire() : valeurs(), codes(), ids_chaines(), codes_ids() {}
+
+/**
+ * @brief Retourne le code d'une valeur, en l'ajoutant au dictionnaire si elle est absente.
+ * @param valeur La chaîne à encoder.
+ * @return Le code de la chaîne.
+ */
+CodeDico Dictionnaire::encoder(string_view valeur) {
+    string cle(valeur);
+    auto it = codes.find(cle);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    CodeDico code = static_cast<CodeDico>(valeurs.size());
+    valeurs.push_back(cle);
+    codes.emplace(std::move(cle), code);
+    return code;
+}
+
+/**
+ * @brief Cherche le code d'une valeur sans l'ajouter.
+ * @param valeur La chaîne recherchée.
+ * @return Le code de la chaîne, ou -1 si elle est absente.
+ */
+int Dictionnaire::chercher(const string& valeur) const {
+    auto it = codes.find(valeur);
+    return it == codes.end() ? -1 : it->second;
+}
+
+/**
+ * @brief Retourne la chaîne correspondant à un code.
+ * @param code Le code à décoder.
+ * @return La chaîne associée.
+ */
+const string& Dictionnaire::decoder(CodeDico code) const {
+    return valeurs[code];
+}
+
+/**
+ * @brief Associe chaque valeur du dictionnaire à son identifiant dans la table globale des chaînes.
+ *
+ * Les voitures et les critères de recherche ne manipulent que des identifiants globaux : cette correspondance
+ * permet de passer d'un code de colonne à un identifiant, et inversement, sans comparer de chaînes.
+ */
+void Dictionnaire::internerValeurs() {
+    TableChaines& table = TableChaines::getInstance();
+    ids_chaines.clear();
+    codes_ids.clear();
+    for (size_t code = 0; code < valeurs.size(); code++) {
+        IdChaine id = table.interner(valeurs[code]);
+        ids_chaines.push_back(id);
+        codes_ids.emplace(id, static_cast<CodeDico>(code));
+    }
+}
+
+/**
+ * @brief Retourne l'identifiant global de la valeur d'un code.
+ * @param code Le code de la valeur.
+ * @return L'identifiant dans la table des chaînes.
+ */
+IdChaine Dictionnaire::getIdChaine(CodeDico code) const {
+    return ids_chaines[code];
+}
+
+/**
+ * @brief Cherche le code d'une valeur à partir de son identifiant global.
+ * @param id L'identifiant dans la table des chaînes.
+ * @return Le code de la valeur, ou -1 si elle est absente.
+ */
+int Dictionnaire::chercherId(IdChaine id) const {
+    auto it = codes_ids.find(id);
+    return it == codes_ids.end() ? -1 : it->second;
+}
+
+/**
+ * @brief Récupère le nombre de valeurs distinctes.
+ * @return La taille du dictionnaire.
+ */
+size_t Dictionnaire::getTaille() const {
+    return valeurs.size();
+}
+
+/**
+ * @brief Vide le dictionnaire.
+ */
+void Dictionnaire::vider() {
+    valeurs.clear();
+    codes.clear();
+    ids_chaines.clear();
+    codes_ids.clear();
+}
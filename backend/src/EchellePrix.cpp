@@ -0,0 +1,26 @@
+/**
+ * @file EchellePrix.cpp
+ * @brief Implémentation de la classe EchellePrix, augmentation paresseuse des prix d'un vendeur.
+ *
+ * Une pénalité de karma augmentait le prix de chaque produit du vendeur, un par un. Elle ne fait plus que
+ * multiplier le facteur cumulé du vendeur, en temps constant. Chaque produit garde la valeur du facteur au
+ * moment où son prix a été fixé : tant que le facteur n'a pas changé, son prix est lu tel quel, sinon il est
+ * multiplié par le rapport des deux facteurs (Produit::getPrix).
+ */
+
+#include "EchellePrix.h"
+
+using namespace std;
+
+/**
+ * @brief Constructeur, aucune augmentation au départ.
+ */
+EchellePrix::EchellePrix() : facteur(1.0) {}
+
+/**
+ * @brief Multiplie le facteur cumulé.
+ * @param f Le multiplicateur, 1.05 pour une augmentation de 5 %.
+ */
+void EchellePrix::multiplier(double f) {
+    facteur.store(facteur.load(memory_order_relaxed) * f, memory_order_relaxed);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file Evenement.cpp
+ * @brief Implémentation de la classe Evenement, réveil d'un acheteur ou d'un vendeur.
+ *
+ * Toutes les attentes et tous les réveils passaient par un seul mutex global, pris aussi par chaque méthode de
+ * stratégie : tout le marché avançait sous un même verrou. Chaque agent a maintenant son propre événement.
+ *
+ * Un agent n'a plus de thread à lui : c'est une coroutine (Negociation). co_await attendre() la suspend s'il ne
+ * reste aucun signal, et garde sa poignée ; signaler soumet sa reprise à l'Ordonnanceur. Un agent n'est donc
+ * repris que lorsqu'un message est arrivé pour lui.
+ *
+ * L'événement était un drapeau, levé jusqu'à ce que l'agent le réinitialise. Avec des threads dédiés, l'agent
+ * se réveillait presque aussitôt ; dans le pool, sa reprise peut attendre derrière d'autres tâches, et un vendeur
+ * qui recevait un break-down puis la recherche d'un autre acheteur effaçait la recherche en réinitialisant son
+ * drapeau après le break-down. L'événement compte maintenant les signaux : chaque message traité en consomme un.
+ * Un agent qui passe la main consomme le sien avant de signaler l'autre, sinon la réponse de l'autre pourrait
+ * arriver avant et être consommée à sa place.
+ */
+
+#include "Evenement.h"
+#include "Ordonnanceur.h"
+#include "Negociation.h"
+
+using namespace std;
+
+/**
+ * @brief Constructeur, l'événement n'a aucun signal et aucun agent suspendu.
+ */
+Evenement::Evenement() : signaux(0), attente(nullptr) {}
+
+/**
+ * @brief Vérifie s'il reste un signal avant de suspendre l'agent.
+ *
+ * Appelée par co_await (await_ready). En mode Negociation::Execution::THREADS, l'agent a son propre thread :
+ * il y attend le prochain signal sur la variable de condition, et la coroutine n'est jamais suspendue.
+ * @return True si l'agent peut continuer sans être suspendu.
+ */
+bool Evenement::avantAttente() {
+    if (Negociation::getExecution() == Negociation::Execution::THREADS) {
+        unique_lock<mutex> lock(mtx);
+        cv.wait(lock, [this] { return signaux > 0; });
+        return true;
+    }
+    return estPret();
+}
+
+/**
+ * @brief Suspend l'agent jusqu'au prochain signal.
+ *
+ * Appelée par co_await une fois la coroutine suspendue. Un signal arrivé depuis await_ready annule la
+ * suspension ; sinon la poignée est gardée, et un autre thread peut reprendre l'agent dès que le verrou est rendu.
+ *
+ * @param h La coroutine de l'agent.
+ * @return False si l'agent doit continuer tout de suite, true s'il reste suspendu.
+ */
+bool Evenement::suspendre(coroutine_handle<> h) {
+    lock_guard<mutex> lock(mtx);
+    if (signaux > 0) {
+        return false;
+    }
+    attente = h;
+    return true;
+}
+
+/**
+ * @brief Ajoute un signal et reprend l'agent s'il était suspendu, ou réveille son thread en mode THREADS.
+ */
+void Evenement::signaler() {
+    coroutine_handle<> reprendre = nullptr;
+    {
+        lock_guard<mutex> lock(mtx);
+        signaux++;
+        reprendre = attente;
+        attente = nullptr;
+    }
+    cv.notify_one();
+    if (reprendre) {
+        Ordonnanceur::getInstance().soumettre([reprendre] { reprendre.resume(); });
+    }
+}
+
+/**
+ * @brief Consomme le signal du message traité : la prochaine attente suspendra l'agent s'il n'en reste pas.
+ */
+void Evenement::consommer() {
+    lock_guard<mutex> lock(mtx);
+    if (signaux > 0) {
+        signaux--;
+    }
+}
+
+/**
+ * @brief Indique s'il reste un signal.
+ * @return True s'il reste au moins un signal.
+ */
+bool Evenement::estPret() {
+    lock_guard<mutex> lock(mtx);
+    return signaux > 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file FiltreLot.cpp
+ * @brief Implémentation de la classe FiltreLot, évaluation vectorisée d'un lot de recherches.
+ *
+ * Quand de nombreux acheteurs interrogent le même vendeur, les recherches sont évaluées ensemble sur les
+ * colonnes de son inventaire. Pour chaque recherche, tous les critères sont comparés sur 8 lignes à la fois
+ * (AVX2) : le masque des lignes qui conviennent sert à retenir, voie par voie, le prix le plus bas et sa ligne.
+ * Les huit voies sont réduites à la fin, les dernières lignes (moins de 8) sont traitées une à une.
+ *
+ * Le choix AVX2 / boucle simple est fait une seule fois, à l'exécution, comme dans AnalyseurCSV. Les deux
+ * versions donnent le même résultat, y compris à prix égal : la ligne la plus petite l'emporte.
+ */
+
+#include "FiltreLot.h"
+#include <limits>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FILTRE_LOT_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ATTRIBUT_AVX2 __attribute__((target("avx2")))
+#else
+#define ATTRIBUT_AVX2
+#endif
+
+using namespace std;
+
+namespace {
+
+typedef void (*FonctionFiltre)(const InventaireColonnes&, const RequeteFiltre&, int32_t&);
+
+atomic<bool> scalaire_force(false);     // Voir FiltreLot::forcerScalaire
+
+bool correspond(const InventaireColonnes& inv, const RequeteFiltre& r, size_t l) {
+    return inv.annees[l] >= r.annee_min
+        && inv.kilometres[l] <= r.kilometres_max
+        && inv.mpgs[l] >= r.mpg_min
+        && inv.tailles_engin[l] >= r.taille_engin_min
+        && (r.marque == TableChaines::VIDE || inv.marques[l] == r.marque)
+        && (r.modele == TableChaines::VIDE || inv.modeles[l] == r.modele)
+        && (r.boite == TableChaines::VIDE || inv.boites[l] == r.boite)
+        && (r.essence == TableChaines::VIDE || inv.essences[l] == r.essence)
+        && (r.categorie == TableChaines::VIDE || inv.categories[l] == r.categorie);
+}
+
+/**
+ * @brief Cherche la ligne la moins chère à partir d'une ligne donnée, une ligne à la fois.
+ * @param inv L'inventaire.
+ * @param r La recherche.
+ * @param debut La première ligne à examiner.
+ * @param ligne La meilleure ligne trouvée jusqu'ici (-1 si aucune), mise à jour.
+ */
+void filtrerScalaire(const InventaireColonnes& inv, const RequeteFiltre& r, size_t debut, int32_t& ligne) {
+    for (size_t l = debut; l < inv.nbr_lignes; l++) {
+        if (correspond(inv, r, l) && (ligne < 0 || inv.prix[l] < inv.prix[ligne])) {
+            ligne = static_cast<int32_t>(l);
+        }
+    }
+}
+
+void filtrerSimple(const InventaireColonnes& inv, const RequeteFiltre& r, int32_t& ligne) {
+    filtrerScalaire(inv, r, 0, ligne);
+}
+
+#ifdef FILTRE_LOT_X86
+// Egalite d'identifiants, vraie pour toutes les lignes si la recherche accepte toutes les valeurs
+ATTRIBUT_AVX2 inline __m256i egalOuToutes(const IdChaine* colonne, size_t l, IdChaine id) {
+    if (id == TableChaines::VIDE) {
+        return _mm256_set1_epi32(-1);
+    }
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(colonne + l));
+    return _mm256_cmpeq_epi32(v, _mm256_set1_epi32(static_cast<int32_t>(id)));
+}
+
+ATTRIBUT_AVX2 void filtrerAVX2(const InventaireColonnes& inv, const RequeteFiltre& r, int32_t& ligne) {
+    const size_t fin_vecteurs = inv.nbr_lignes & ~size_t(7);
+    // annee >= min  <=>  annee > min - 1
+    const __m256i annee_min = _mm256_set1_epi32(r.annee_min == numeric_limits<int32_t>::min() ? r.annee_min
+                                                                                             : r.annee_min - 1);
+    const __m256i kilometres_max = _mm256_set1_epi32(r.kilometres_max);
+    const __m256 mpg_min = _mm256_set1_ps(r.mpg_min);
+    const __m256 taille_min = _mm256_set1_ps(r.taille_engin_min);
+
+    __m256 meilleur_prix = _mm256_set1_ps(numeric_limits<float>::infinity());
+    __m256i meilleure_ligne = _mm256_set1_epi32(-1);
+    __m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i huit = _mm256_set1_epi32(8);
+
+    for (size_t l = 0; l < fin_vecteurs; l += 8) {
+        __m256i annees = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inv.annees + l));
+        __m256i kilometres = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inv.kilometres + l));
+        __m256i ok = _mm256_cmpgt_epi32(annees, annee_min);
+        ok = _mm256_andnot_si256(_mm256_cmpgt_epi32(kilometres, kilometres_max), ok);
+        ok = _mm256_and_si256(ok, _mm256_castps_si256(
+                 _mm256_cmp_ps(_mm256_loadu_ps(inv.mpgs + l), mpg_min, _CMP_GE_OQ)));
+        ok = _mm256_and_si256(ok, _mm256_castps_si256(
+                 _mm256_cmp_ps(_mm256_loadu_ps(inv.tailles_engin + l), taille_min, _CMP_GE_OQ)));
+        ok = _mm256_and_si256(ok, egalOuToutes(inv.marques, l, r.marque));
+        ok = _mm256_and_si256(ok, egalOuToutes(inv.modeles, l, r.modele));
+        ok = _mm256_and_si256(ok, egalOuToutes(inv.boites, l, r.boite));
+        ok = _mm256_and_si256(ok, egalOuToutes(inv.essences, l, r.essence));
+        ok = _mm256_and_si256(ok, egalOuToutes(inv.categories, l, r.categorie));
+
+        // Strictement moins cher : a prix egal, chaque voie garde sa premiere ligne
+        __m256 prix = _mm256_loadu_ps(inv.prix + l);
+        __m256 mieux = _mm256_and_ps(_mm256_cmp_ps(prix, meilleur_prix, _CMP_LT_OQ), _mm256_castsi256_ps(ok));
+        meilleur_prix = _mm256_blendv_ps(meilleur_prix, prix, mieux);
+        meilleure_ligne = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(meilleure_ligne),
+                                                               _mm256_castsi256_ps(indices), mieux));
+        indices = _mm256_add_epi32(indices, huit);
+    }
+
+    alignas(32) float prix_voies[8];
+    alignas(32) int32_t lignes_voies[8];
+    _mm256_store_ps(prix_voies, meilleur_prix);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lignes_voies), meilleure_ligne);
+    for (int v = 0; v < 8; v++) {
+        if (lignes_voies[v] < 0) {
+            continue;
+        }
+        if (ligne < 0 || prix_voies[v] < inv.prix[ligne]
+            || (prix_voies[v] == inv.prix[ligne] && lignes_voies[v] < ligne)) {
+            ligne = lignes_voies[v];
+        }
+    }
+    filtrerScalaire(inv, r, fin_vecteurs, ligne);
+}
+
+bool supporteAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+#endif
+
+/**
+ * @brief Choisit une fois pour toutes la version du filtre adaptée au processeur.
+ * @return La fonction d'évaluation d'une recherche, la boucle simple si elle est forcée.
+ */
+FonctionFiltre fonctionFiltre() {
+#ifdef FILTRE_LOT_X86
+    static const FonctionFiltre fonction = supporteAVX2() ? filtrerAVX2 : filtrerSimple;
+#else
+    static const FonctionFiltre fonction = filtrerSimple;
+#endif
+    return scalaire_force.load(memory_order_relaxed) ? filtrerSimple : fonction;
+}
+
+}
+
+/**
+ * @brief Cherche la ligne la moins chère de chaque recherche d'un lot.
+ * @param inventaire Les colonnes de l'inventaire, prix compris.
+ * @param requetes Les recherches.
+ * @param lignes Rempli avec une ligne par recherche, -1 si aucune ligne ne convient.
+ */
+void FiltreLot::moinsChers(const InventaireColonnes& inventaire, const vector<RequeteFiltre>& requetes,
+                           vector<int32_t>& lignes) {
+    FonctionFiltre filtrer = fonctionFiltre();
+    lignes.assign(requetes.size(), -1);
+    for (size_t i = 0; i < requetes.size(); i++) {
+        filtrer(inventaire, requetes[i], lignes[i]);
+    }
+}
+
+/**
+ * @brief Indique le nom du jeu d'instructions utilisé pour filtrer.
+ * @return "AVX2" ou "scalaire".
+ */
+const char* FiltreLot::getJeuInstructions() {
+#ifdef FILTRE_LOT_X86
+    return fonctionFiltre() == filtrerAVX2 ? "AVX2" : "scalaire";
+#else
+    return "scalaire";
+#endif
+}
+
+/**
+ * @brief Force la boucle simple à la place de la version AVX2, pour les comparer dans les tests.
+ * @param scalaire True pour la boucle simple, false pour revenir au choix selon le processeur.
+ */
+void FiltreLot::forcerScalaire(bool scalaire) {
+    scalaire_force.store(scalaire, memory_order_relaxed);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file GenerateurAleatoire.cpp
+ * @brief Implémentation de la classe GenerateurAleatoire, nombres pseudo-aléatoires reproductibles par agent.
+ *
+ * Remplace rand()/srand(time(NULL)) : rand() partage un état global entre tous les threads de négociation et rend
+ * chaque exécution différente. Ici, chaque vendeur et chaque acheteur tire dans son propre flux xoshiro256**,
+ * dérivé de la graine de session, de sa famille et de son identifiant. Deux exécutions avec la même graine
+ * tirent donc exactement les mêmes nombres, et aucun verrou n'est pris pour tirer un nombre.
+ */
+
+#include "GenerateurAleatoire.h"
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <climits>
+
+using namespace std;
+
+atomic<uint64_t> GenerateurAleatoire::graine_session(0);
+
+namespace {
+
+/**
+ * @brief Mélange splitmix64, utilisé pour dériver les états initiaux à partir d'une graine.
+ * @param x L'état de splitmix64, avancé à chaque appel.
+ * @return La valeur suivante.
+ */
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotation(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+}
+
+/**
+ * @brief Constructeur d'un générateur à partir d'une graine.
+ * @param graine La graine, toute valeur (0 compris) donne un état valide.
+ */
+GenerateurAleatoire::GenerateurAleatoire(uint64_t graine) {
+    for (int i = 0; i < 4; i++) {
+        etat[i] = splitmix64(graine);
+    }
+}
+
+/**
+ * @brief Tire le nombre suivant du flux.
+ * @return 64 bits pseudo-aléatoires.
+ */
+uint64_t GenerateurAleatoire::suivant() {
+    uint64_t resultat = rotation(etat[1] * 5, 7) * 9;
+    uint64_t t = etat[1] << 17;
+    etat[2] ^= etat[0];
+    etat[3] ^= etat[1];
+    etat[1] ^= etat[2];
+    etat[0] ^= etat[3];
+    etat[2] ^= t;
+    etat[3] = rotation(etat[3], 45);
+    return resultat;
+}
+
+/**
+ * @brief Tire un entier uniforme entre deux bornes incluses.
+ *
+ * Les bornes peuvent être données dans n'importe quel ordre.
+ * @param min La première borne.
+ * @param max La seconde borne.
+ * @return Un entier entre min et max.
+ */
+int GenerateurAleatoire::entre(int min, int max) {
+    if (min > max) {
+        int temp = min;
+        min = max;
+        max = temp;
+    }
+    uint64_t nombre = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    uint64_t tirage = suivant() >> 32;
+    return static_cast<int>(min + static_cast<int64_t>((tirage * nombre) >> 32));
+}
+
+/**
+ * @brief Fixe la graine de session.
+ *
+ * S'applique aux flux créés ensuite : vendeurs générés, acheteurs de la prochaine négociation.
+ * @param graine La graine de session, 0 pour en tirer une nouvelle au hasard.
+ */
+void GenerateurAleatoire::setGraineSession(uint64_t graine) {
+    graine_session = graine;
+}
+
+/**
+ * @brief Récupère la graine de session.
+ *
+ * Si aucune graine n'a été fixée, une graine est tirée au hasard et affichée, pour pouvoir rejouer l'exécution.
+ * Elle reste inférieure à INT_MAX pour pouvoir être saisie dans l'interface.
+ * @return La graine de session.
+ */
+uint64_t GenerateurAleatoire::getGraineSession() {
+    uint64_t graine = graine_session;
+    if (graine != 0) {
+        return graine;
+    }
+    random_device source;
+    uint64_t hasard = (static_cast<uint64_t>(source()) << 32)
+                    ^ static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+    uint64_t nouvelle = splitmix64(hasard) % INT_MAX + 1;
+    if (graine_session.compare_exchange_strong(graine, nouvelle)) {
+        cout << "Graine de session: " << nouvelle << endl;
+        return nouvelle;
+    }
+    return graine;  // Tirée entre-temps par un autre thread
+}
+
+/**
+ * @brief Crée le flux d'un agent, dérivé de la graine de session.
+ * @param famille Le type d'agent.
+ * @param indice L'identifiant de l'agent dans sa famille.
+ * @return Le générateur de l'agent.
+ */
+GenerateurAleatoire GenerateurAleatoire::flux(Famille famille, uint64_t indice) {
+    uint64_t x = getGraineSession();
+    uint64_t graine = splitmix64(x) ^ (static_cast<uint64_t>(famille) << 56) ^ indice;
+    return GenerateurAleatoire(splitmix64(graine));
+}
@@ -0,0 +1,344 @@
+/**
+ * @file IndexAttributs.cpp
+ * @brief Implémentation de la classe IndexAttributs, recherche par intervalles sur plusieurs attributs.
+ *
+ * Une recherche personnalisée (onglet "custom" du magasin) ne précise en général ni la marque ni le modèle,
+ * seulement des bornes : année minimale, kilométrage maximal, consommation et taille du moteur minimales.
+ * Chercher le moins cher revenait à parcourir tout l'inventaire.
+ *
+ * Ici, les attributs sont rangés en colonnes et, pour chaque groupe (tout l'inventaire, puis chaque marque), les
+ * lignes sont triées selon chacun des quatre attributs numériques. Une borne devient une recherche dichotomique
+ * qui délimite l'intervalle des lignes qui la respectent ; seul le plus petit intervalle est parcouru, les autres
+ * critères étant vérifiés dans les colonnes. "Une Audi d'après 2015 à moins de 50000 km" ne parcourt ainsi que
+ * les Audi d'après 2015, ou les Audi à moins de 50000 km si elles sont moins nombreuses.
+ *
+ * Les groupes ne sont reconstruits qu'à la première recherche qui suit un ajout. Une voiture vendue ne déclenche
+ * pas de reconstruction : sa ligne est marquée morte (produit nul) et sautée pendant les parcours. Les lignes
+ * mortes ne sont retirées, et les groupes retriés, que lorsqu'elles dépassent une part fixe de l'index
+ * (PART_MORTES) : une vente ne coûte plus quatre tris de tout l'inventaire à la recherche suivante. Les prix ne
+ * sont pas indexés : ils changent pendant les négociations et sont lus sur les produits.
+ */
+
+#include "IndexAttributs.h"
+#include "Voiture.h"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+using namespace std;
+
+/**
+ * @brief Constructeur d'un index vide.
+ */
+IndexAttributs::IndexAttributs() : nbr_mortes(0), a_jour(true) {}
+
+/**
+ * @brief Ajoute une voiture à l'index. Les autres produits sont ignorés.
+ * @param p Le produit.
+ */
+void IndexAttributs::ajouter(const shared_ptr<Produit>& p) {
+    const Voiture* v = commeVoiture(p.get());
+    if (v == nullptr) {
+        return;
+    }
+    ligne_de[p.get()] = static_cast<uint32_t>(produits.size());
+    produits.push_back(p);
+    annees.push_back(v->getYear());
+    kilometres.push_back(v->getKilometres());
+    mpgs.push_back(v->getMPG());
+    tailles_engin.push_back(v->getTailleEngin());
+    marques.push_back(v->getIdBrand());
+    modeles.push_back(v->getIdModel());
+    boites.push_back(v->getIdBoiteDeVitesse());
+    essences.push_back(v->getIdEssence());
+    categories.push_back(v->getIdCategorie());
+    a_jour = false;
+}
+
+/**
+ * @brief Retire un produit de l'index en temps constant : sa ligne est marquée morte.
+ *
+ * Les groupes triés restent valides, les parcours sautent la ligne. Elle disparaît à la prochaine
+ * reconstruction, quand les lignes mortes dépassent une ligne sur PART_MORTES.
+ * @param p Le produit.
+ */
+void IndexAttributs::retirer(const Produit* p) {
+    auto it = ligne_de.find(p);
+    if (it == ligne_de.end()) {
+        return;
+    }
+    produits[it->second] = nullptr;
+    ligne_de.erase(it);
+    nbr_mortes++;
+    if (nbr_mortes * PART_MORTES > produits.size()) {
+        a_jour = false;
+    }
+}
+
+/**
+ * @brief Vide l'index.
+ */
+void IndexAttributs::vider() {
+    produits.clear();
+    ligne_de.clear();
+    annees.clear();
+    kilometres.clear();
+    mpgs.clear();
+    tailles_engin.clear();
+    marques.clear();
+    modeles.clear();
+    boites.clear();
+    essences.clear();
+    categories.clear();
+    prix_lot.clear();
+    nbr_mortes = 0;
+    tous = Groupe();
+    par_marque.clear();
+    a_jour = true;
+}
+
+/**
+ * @brief Trie les lignes d'un groupe selon chacun des attributs numériques.
+ *
+ * Les tris sont stables : à valeur égale, les lignes restent dans l'ordre d'ajout.
+ * @param g Le groupe, dont les lignes sont déjà remplies par ordre croissant.
+ */
+void IndexAttributs::trierGroupe(Groupe& g) const {
+    g.par_annee = g.lignes;
+    stable_sort(g.par_annee.begin(), g.par_annee.end(),
+                [this](uint32_t a, uint32_t b) { return annees[a] < annees[b]; });
+    g.par_kilometres = g.lignes;
+    stable_sort(g.par_kilometres.begin(), g.par_kilometres.end(),
+                [this](uint32_t a, uint32_t b) { return kilometres[a] < kilometres[b]; });
+    g.par_mpg = g.lignes;
+    stable_sort(g.par_mpg.begin(), g.par_mpg.end(),
+                [this](uint32_t a, uint32_t b) { return mpgs[a] < mpgs[b]; });
+    g.par_taille = g.lignes;
+    stable_sort(g.par_taille.begin(), g.par_taille.end(),
+                [this](uint32_t a, uint32_t b) { return tailles_engin[a] < tailles_engin[b]; });
+}
+
+/**
+ * @brief Supprime les lignes mortes en gardant l'ordre des lignes vivantes.
+ */
+void IndexAttributs::compacter() {
+    size_t ecrite = 0;
+    for (size_t ligne = 0; ligne < produits.size(); ligne++) {
+        if (produits[ligne] == nullptr) {
+            continue;
+        }
+        if (ecrite != ligne) {
+            produits[ecrite] = move(produits[ligne]);
+            annees[ecrite] = annees[ligne];
+            kilometres[ecrite] = kilometres[ligne];
+            mpgs[ecrite] = mpgs[ligne];
+            tailles_engin[ecrite] = tailles_engin[ligne];
+            marques[ecrite] = marques[ligne];
+            modeles[ecrite] = modeles[ligne];
+            boites[ecrite] = boites[ligne];
+            essences[ecrite] = essences[ligne];
+            categories[ecrite] = categories[ligne];
+            ligne_de[produits[ecrite].get()] = static_cast<uint32_t>(ecrite);
+        }
+        ecrite++;
+    }
+    produits.resize(ecrite);
+    annees.resize(ecrite);
+    kilometres.resize(ecrite);
+    mpgs.resize(ecrite);
+    tailles_engin.resize(ecrite);
+    marques.resize(ecrite);
+    modeles.resize(ecrite);
+    boites.resize(ecrite);
+    essences.resize(ecrite);
+    categories.resize(ecrite);
+    nbr_mortes = 0;
+}
+
+/**
+ * @brief Reconstruit le groupe de tout l'inventaire et ceux de chaque marque, sans les lignes mortes.
+ */
+void IndexAttributs::construire() {
+    if (nbr_mortes > 0) {
+        compacter();
+    }
+    tous = Groupe();
+    par_marque.clear();
+    tous.lignes.resize(produits.size());
+    iota(tous.lignes.begin(), tous.lignes.end(), 0u);
+    for (uint32_t ligne = 0; ligne < produits.size(); ligne++) {
+        par_marque[marques[ligne]].lignes.push_back(ligne);
+    }
+    trierGroupe(tous);
+    for (auto& g : par_marque) {
+        trierGroupe(g.second);
+    }
+    a_jour = true;
+}
+
+/**
+ * @brief Vérifie qu'une ligne satisfait tous les critères d'une voiture recherchée, hors catégorie.
+ *
+ * Mêmes règles que Vendeur::correspondVoiture : une chaîne vide ou une valeur nulle signifie "peu importe".
+ * @param ligne La ligne de l'index.
+ * @param critere La voiture recherchée.
+ * @return True si la ligne correspond.
+ */
+bool IndexAttributs::correspond(uint32_t ligne, const Voiture& critere) const {
+    return (critere.getIdBrand() == TableChaines::VIDE || marques[ligne] == critere.getIdBrand())
+        && (critere.getIdModel() == TableChaines::VIDE || modeles[ligne] == critere.getIdModel())
+        && annees[ligne] >= critere.getYear()
+        && (critere.getIdBoiteDeVitesse() == TableChaines::VIDE || boites[ligne] == critere.getIdBoiteDeVitesse())
+        && (critere.getKilometres() == 0 || kilometres[ligne] <= critere.getKilometres())
+        && (critere.getIdEssence() == TableChaines::VIDE || essences[ligne] == critere.getIdEssence())
+        && (critere.getMPG() == 0 || mpgs[ligne] >= critere.getMPG())
+        && (critere.getTailleEngin() == 0 || tailles_engin[ligne] >= critere.getTailleEngin());
+}
+
+/**
+ * @brief Cherche la voiture la moins chère qui satisfait un critère.
+ *
+ * Chaque borne précisée délimite, par dichotomie, un intervalle de lignes dans le groupe de la marque (ou de
+ * tout l'inventaire). Seul le plus court de ces intervalles est parcouru.
+ * @param critere La voiture recherchée, partiellement renseignée.
+ * @return La voiture la moins chère qui correspond, ou nullptr.
+ */
+shared_ptr<Produit> IndexAttributs::moinsCher(const Voiture& critere) {
+    if (!a_jour) {
+        construire();
+    }
+
+    const Groupe* g = &tous;
+    if (critere.getIdBrand() != TableChaines::VIDE) {
+        auto it = par_marque.find(critere.getIdBrand());
+        if (it == par_marque.end()) {
+            return nullptr;
+        }
+        g = &it->second;
+    }
+
+    // Intervalle a parcourir, initialement tout le groupe
+    const uint32_t* debut = g->lignes.data();
+    const uint32_t* fin = debut + g->lignes.size();
+    auto restreindre = [&debut, &fin](const uint32_t* d, const uint32_t* f) {
+        if (f - d < fin - debut) {
+            debut = d;
+            fin = f;
+        }
+    };
+
+    if (critere.getYear() != 0) {
+        const vector<uint32_t>& v = g->par_annee;
+        auto it = partition_point(v.begin(), v.end(), [&](uint32_t l) { return annees[l] < critere.getYear(); });
+        restreindre(v.data() + (it - v.begin()), v.data() + v.size());
+    }
+    if (critere.getKilometres() != 0) {
+        const vector<uint32_t>& v = g->par_kilometres;
+        auto it = partition_point(v.begin(), v.end(), [&](uint32_t l) { return kilometres[l] <= critere.getKilometres(); });
+        restreindre(v.data(), v.data() + (it - v.begin()));
+    }
+    if (critere.getMPG() != 0) {
+        const vector<uint32_t>& v = g->par_mpg;
+        auto it = partition_point(v.begin(), v.end(), [&](uint32_t l) { return mpgs[l] < critere.getMPG(); });
+        restreindre(v.data() + (it - v.begin()), v.data() + v.size());
+    }
+    if (critere.getTailleEngin() != 0) {
+        const vector<uint32_t>& v = g->par_taille;
+        auto it = partition_point(v.begin(), v.end(), [&](uint32_t l) { return tailles_engin[l] < critere.getTailleEngin(); });
+        restreindre(v.data() + (it - v.begin()), v.data() + v.size());
+    }
+
+    bool toute_categorie = critere.getIdCategorie() == TableChaines::VIDE;
+    long meilleure = -1;
+    float meilleur_prix = 0.0f;
+    for (const uint32_t* l = debut; l != fin; ++l) {
+        if (produits[*l] == nullptr || !correspond(*l, critere)) {
+            continue;
+        }
+        if (!toute_categorie && categories[*l] != critere.getIdCategorie()) {
+            continue;
+        }
+        float prix = produits[*l]->getPrix();
+        if (meilleure < 0 || prix < meilleur_prix || (prix == meilleur_prix && *l < meilleure)) {
+            meilleure = *l;
+            meilleur_prix = prix;
+        }
+    }
+    return meilleure < 0 ? nullptr : produits[meilleure];
+}
+
+/**
+ * @brief Traduit une voiture recherchée en bornes pour FiltreLot.
+ * @param critere La voiture recherchée.
+ * @return La requête équivalente.
+ */
+RequeteFiltre IndexAttributs::traduire(const Voiture& critere) {
+    RequeteFiltre r;
+    r.annee_min = critere.getYear();
+    if (critere.getKilometres() != 0) {
+        r.kilometres_max = critere.getKilometres();
+    }
+    if (critere.getMPG() != 0) {
+        r.mpg_min = critere.getMPG();
+    }
+    if (critere.getTailleEngin() != 0) {
+        r.taille_engin_min = critere.getTailleEngin();
+    }
+    r.marque = critere.getIdBrand();
+    r.modele = critere.getIdModel();
+    r.boite = critere.getIdBoiteDeVitesse();
+    r.essence = critere.getIdEssence();
+    r.categorie = critere.getIdCategorie();
+    return r;
+}
+
+/**
+ * @brief Cherche la voiture la moins chère pour chaque recherche d'un lot.
+ *
+ * Les prix sont relevés une fois sur les produits, puis toutes les recherches sont évaluées sur les colonnes
+ * par FiltreLot. Une ligne morte a un prix infini : toute ligne vivante qui convient passe avant elle, et une
+ * recherche qui ne trouve qu'elle n'a pas de résultat. Le résultat est celui de moinsCher appliquée à chaque
+ * recherche.
+ * @param criteres Les voitures recherchées.
+ * @param resultats Rempli avec un produit par recherche, nullptr si aucun.
+ */
+void IndexAttributs::moinsChersLot(const vector<const Voiture*>& criteres, vector<shared_ptr<Produit>>& resultats) {
+    prix_lot.resize(produits.size());
+    for (size_t l = 0; l < produits.size(); l++) {
+        prix_lot[l] = produits[l] != nullptr ? produits[l]->getPrix() : numeric_limits<float>::infinity();
+    }
+
+    InventaireColonnes inventaire;
+    inventaire.nbr_lignes = produits.size();
+    inventaire.annees = annees.data();
+    inventaire.kilometres = kilometres.data();
+    inventaire.mpgs = mpgs.data();
+    inventaire.tailles_engin = tailles_engin.data();
+    inventaire.prix = prix_lot.data();
+    inventaire.marques = marques.data();
+    inventaire.modeles = modeles.data();
+    inventaire.boites = boites.data();
+    inventaire.essences = essences.data();
+    inventaire.categories = categories.data();
+
+    vector<RequeteFiltre> requetes;
+    requetes.reserve(criteres.size());
+    for (const Voiture* c : criteres) {
+        requetes.push_back(traduire(*c));
+    }
+    vector<int32_t> lignes;
+    FiltreLot::moinsChers(inventaire, requetes, lignes);
+
+    resultats.resize(criteres.size());
+    for (size_t i = 0; i < criteres.size(); i++) {
+        resultats[i] = lignes[i] < 0 ? nullptr : produits[lignes[i]]; //nullptr aussi pour une ligne morte
+    }
+}
+
+/**
+ * @brief Récupère le nombre de voitures indexées.
+ * @return La taille de l'index.
+ */
+size_t IndexAttributs::getTaille() const {
+    return produits.size() - nbr_mortes;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file IndexProduits.cpp
+ * @brief Implémentation de la classe IndexProduits, index par (marque, modèle) des produits d'un vendeur.
+ *
+ * Une recherche "search" demande presque toujours une marque et un modèle précis. Au lieu de parcourir tout
+ * l'inventaire, le vendeur consulte le seau correspondant, déjà trié par prix croissant, et s'arrête au premier
+ * produit qui satisfait les autres critères. Les seaux sont rangés par les identifiants internés de la marque
+ * et du modèle, qu'ils viennent du catalogue ou non.
+ *
+ * Le prix d'un produit peut aussi être modifié hors du vendeur (l'acheteur fixe le prix conclu sur le produit
+ * partagé). L'ordre d'un seau est donc vérifié à chaque consultation et rétabli s'il a été perdu, ce qui coûte
+ * un simple parcours du seau.
+ */
+
+#include "IndexProduits.h"
+#include "Voiture.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+bool moinsCher(const IndexProduits::Entree& a, const IndexProduits::Entree& b) {
+    return a.produit->getPrix() < b.produit->getPrix();
+}
+
+}
+
+/**
+ * @brief Calcule la clé d'un seau.
+ * @param marque L'identifiant de la marque.
+ * @param modele L'identifiant du modèle.
+ * @return La clé du seau.
+ */
+uint64_t IndexProduits::cle(IdChaine marque, IdChaine modele) {
+    return (static_cast<uint64_t>(marque) << 32) | modele;
+}
+
+/**
+ * @brief Insère une entrée à sa place dans un seau trié par prix.
+ * @param seau Le seau.
+ * @param e L'entrée à insérer.
+ */
+void IndexProduits::inserer(vector<Entree>& seau, const Entree& e) {
+    trier(seau);
+    seau.insert(upper_bound(seau.begin(), seau.end(), e, moinsCher), e);
+}
+
+/**
+ * @brief Enlève un produit d'un seau en conservant l'ordre.
+ * @param seau Le seau.
+ * @param p Le produit à enlever.
+ */
+void IndexProduits::enlever(vector<Entree>& seau, const Produit* p) {
+    auto it = find_if(seau.begin(), seau.end(), [p](const Entree& e) { return e.produit.get() == p; });
+    if (it != seau.end()) {
+        seau.erase(it);
+    }
+}
+
+/**
+ * @brief Rétablit l'ordre par prix d'un seau s'il a été perdu.
+ * @param seau Le seau.
+ * @return Le seau trié.
+ */
+const vector<IndexProduits::Entree>& IndexProduits::trier(vector<Entree>& seau) {
+    if (!is_sorted(seau.begin(), seau.end(), moinsCher)) {
+        stable_sort(seau.begin(), seau.end(), moinsCher);
+    }
+    return seau;
+}
+
+/**
+ * @brief Ajoute un produit à l'index.
+ * @param p Le produit.
+ * @param ligne Sa ligne dans le catalogue en colonnes, -1 s'il est hors catalogue.
+ */
+void IndexProduits::ajouter(const shared_ptr<Produit>& p, int ligne) {
+    par_id.emplace(p->getId(), p);
+    attributs.ajouter(p);
+    if (const Voiture* v = commeVoiture(p.get())) {
+        inserer(seaux[cle(v->getIdBrand(), v->getIdModel())], {p, ligne});
+    }
+}
+
+/**
+ * @brief Retire un produit de l'index.
+ * @param p Le produit.
+ */
+void IndexProduits::retirer(const Produit* p) {
+    auto meme_id = par_id.find(p->getId());
+    if (meme_id != par_id.end() && meme_id->second.get() == p) {
+        par_id.erase(meme_id);
+    }
+    attributs.retirer(p);
+
+    if (const Voiture* v = commeVoiture(p)) {
+        auto it = seaux.find(cle(v->getIdBrand(), v->getIdModel()));
+        if (it != seaux.end()) {
+            enlever(it->second, p);
+            if (it->second.empty()) {
+                seaux.erase(it);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Vide l'index.
+ */
+void IndexProduits::vider() {
+    seaux.clear();
+    par_id.clear();
+    attributs.vider();
+}
+
+/**
+ * @brief Rétablit l'ordre de tous les seaux après une modification des prix.
+ *
+ * Une augmentation du même pourcentage pour tous les produits conserve l'ordre : chaque seau est alors
+ * seulement vérifié.
+ */
+void IndexProduits::reordonner() {
+    for (auto& seau : seaux) {
+        trier(seau.second);
+    }
+}
+
+/**
+ * @brief Cherche un produit par son identifiant.
+ * @param id L'identifiant.
+ * @return Le produit ayant cet identifiant, ou nullptr.
+ */
+shared_ptr<Produit> IndexProduits::chercherId(int id) const {
+    auto it = par_id.find(id);
+    return it == par_id.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Récupère le seau des produits d'une marque et d'un modèle.
+ * @param marque L'identifiant de la marque.
+ * @param modele L'identifiant du modèle.
+ * @return Le seau trié par prix croissant, ou nullptr s'il est vide.
+ */
+const vector<IndexProduits::Entree>* IndexProduits::seau(IdChaine marque, IdChaine modele) {
+    auto it = seaux.find(cle(marque, modele));
+    return it == seaux.end() ? nullptr : &trier(it->second);
+}
+
+/**
+ * @brief Cherche le produit le moins cher par intervalles sur l'année, le kilométrage, la consommation et le moteur.
+ * @param critere La voiture recherchée, sans marque ou sans modèle.
+ * @return Le produit le moins cher qui correspond, ou nullptr.
+ */
+shared_ptr<Produit> IndexProduits::chercherAttributs(const Voiture& critere) {
+    return attributs.moinsCher(critere);
+}
+
+/**
+ * @brief Cherche le produit le moins cher de chaque recherche d'un lot, sur les colonnes de l'inventaire.
+ * @param criteres Les voitures recherchées.
+ * @param resultats Rempli avec un produit par recherche, nullptr si aucun.
+ */
+void IndexProduits::chercherLot(const vector<const Voiture*>& criteres, vector<shared_ptr<Produit>>& resultats) {
+    attributs.moinsChersLot(criteres, resultats);
+}
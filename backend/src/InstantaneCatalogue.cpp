@@ -0,0 +1,343 @@
+/**
+ * @file InstantaneCatalogue.cpp
+ * @brief Implémentation de la classe InstantaneCatalogue, sauvegarde binaire du catalogue en colonnes.
+ *
+ * Le premier lancement décode les fichiers CSV puis écrit un instantané binaire à côté d'eux. Les lancements
+ * suivants projettent l'instantané en mémoire et copient directement les colonnes, sans aucun décodage de texte.
+ *
+ * Format (ordre des octets de la machine, vérifié par un marqueur) :
+ *  - en-tête : magie, version, marqueur d'ordre, nombre de sources, de colonnes et de lignes, somme du contenu ;
+ *  - une entrée par fichier CSV source : taille, date de modification, somme de contrôle ;
+ *  - le début de chaque marque ;
+ *  - la table des colonnes : identifiant, type et position de chaque colonne typée ;
+ *  - les quatre dictionnaires (longueur + octets de chaque chaîne) ;
+ *  - les données des colonnes, alignées sur 8 octets.
+ *
+ * L'instantané est rejeté si la version, l'ordre des octets ou la somme du contenu ne correspondent pas, ou si un
+ * fichier source a changé de taille. Si seule la date d'un fichier a changé, sa somme de contrôle est recalculée :
+ * un contenu identique garde l'instantané valide.
+ */
+
+#include "InstantaneCatalogue.h"
+#include <cstring>
+#include <fstream>
+#include <cstdio>
+#include "ProjectionFichier.h"
+
+using namespace std;
+
+const uint32_t InstantaneCatalogue::VERSION = 2;
+const string InstantaneCatalogue::NOM_FICHIER = "catalogue.bin";
+
+namespace {
+
+const char MAGIE[8] = {'N', 'E', 'G', 'O', 'C', 'A', 'T', '\0'};
+const uint32_t ORDRE_OCTETS = 0x01020304;
+
+enum TypeColonne : uint32_t {
+    TYPE_INT32 = 1,
+    TYPE_FLOAT32 = 2,
+    TYPE_CODE16 = 3,
+};
+
+enum IdColonne : uint32_t {
+    COL_ANNEES = 0,
+    COL_PRIX,
+    COL_KILOMETRES,
+    COL_TAXES,
+    COL_MPGS,
+    COL_TAILLES_ENGIN,
+    COL_MARQUES,
+    COL_MODELES,
+    COL_BOITES,
+    COL_ESSENCES,
+    NBR_COLONNES
+};
+
+struct EnTete {
+    char magie[8];
+    uint32_t version;
+    uint32_t ordre_octets;
+    uint32_t nbr_sources;
+    uint32_t nbr_colonnes;
+    uint64_t nbr_lignes;
+    uint64_t somme_contenu;     // Somme de tout ce qui suit l'en-tête
+};
+
+struct EntreeSource {
+    uint64_t taille;
+    int64_t date_modif;
+    uint64_t somme;
+};
+
+struct EntreeColonne {
+    uint32_t identifiant;
+    uint32_t type;
+    uint64_t position;          // Depuis le début du fichier
+};
+
+// Écriture séquentielle dans un tampon
+struct Tampon {
+    vector<char> octets;
+
+    void ajouter(const void* d, size_t n) {
+        const char* c = static_cast<const char*>(d);
+        octets.insert(octets.end(), c, c + n);
+    }
+    template <typename T>
+    void ajouterValeur(const T& v) {
+        ajouter(&v, sizeof(T));
+    }
+    void aligner() {
+        while (octets.size() % 8 != 0) {
+            octets.push_back(0);
+        }
+    }
+};
+
+// Lecture séquentielle avec contrôle des bornes
+struct Lecteur {
+    const char* debut;
+    size_t taille;
+    size_t pos;
+
+    bool lire(void* d, size_t n) {
+        if (pos + n > taille) {
+            return false;
+        }
+        memcpy(d, debut + pos, n);
+        pos += n;
+        return true;
+    }
+    template <typename T>
+    bool lireValeur(T& v) {
+        return lire(&v, sizeof(T));
+    }
+};
+
+void ecrireDictionnaire(Tampon& t, const Dictionnaire& d) {
+    t.ajouterValeur(static_cast<uint32_t>(d.getTaille()));
+    for (size_t i = 0; i < d.getTaille(); i++) {
+        const string& s = d.decoder(static_cast<CodeDico>(i));
+        t.ajouterValeur(static_cast<uint32_t>(s.size()));
+        t.ajouter(s.data(), s.size());
+    }
+}
+
+bool lireDictionnaire(Lecteur& l, Dictionnaire& d) {
+    uint32_t nbr = 0;
+    if (!l.lireValeur(nbr)) {
+        return false;
+    }
+    d.vider();
+    for (uint32_t i = 0; i < nbr; i++) {
+        uint32_t longueur = 0;
+        if (!l.lireValeur(longueur) || l.pos + longueur > l.taille) {
+            return false;
+        }
+        d.encoder(string_view(l.debut + l.pos, longueur));
+        l.pos += longueur;
+    }
+    return d.getTaille() == nbr;
+}
+
+template <typename T>
+void ecrireColonne(Tampon& t, vector<EntreeColonne>& table, uint32_t id, uint32_t type, const vector<T>& colonne) {
+    t.aligner();
+    table.push_back({id, type, static_cast<uint64_t>(t.octets.size())});
+    t.ajouter(colonne.data(), colonne.size() * sizeof(T));
+}
+
+template <typename T>
+bool lireColonne(const ProjectionFichier& p, const EntreeColonne& e, uint32_t type, uint64_t nbr_lignes, vector<T>& colonne) {
+    if (e.type != type || e.position + nbr_lignes * sizeof(T) > p.getTaille()) {
+        return false;
+    }
+    const T* d = reinterpret_cast<const T*>(p.getDebut() + e.position);
+    colonne.assign(d, d + nbr_lignes);
+    return true;
+}
+
+}
+
+/**
+ * @brief Récupère la somme de contrôle du fichier source, calculée à la première demande.
+ * @return La somme de contrôle du contenu.
+ */
+uint64_t EtatSource::getSomme() {
+    if (!somme_calculee) {
+        somme = InstantaneCatalogue::sommeControle(donnees, taille);
+        somme_calculee = true;
+    }
+    return somme;
+}
+
+/**
+ * @brief Calcule une somme de contrôle 64 bits (FNV-1a appliqué par mots de 8 octets).
+ * @param donnees Les octets à contrôler.
+ * @param taille Le nombre d'octets.
+ * @return La somme de contrôle.
+ */
+uint64_t InstantaneCatalogue::sommeControle(const char* donnees, size_t taille) {
+    uint64_t h = 14695981039346656037ULL;
+    const uint64_t premier = 1099511628211ULL;
+    size_t i = 0;
+    for (; i + 8 <= taille; i += 8) {
+        uint64_t mot;
+        memcpy(&mot, donnees + i, 8);
+        h = (h ^ mot) * premier;
+    }
+    for (; i < taille; i++) {
+        h = (h ^ static_cast<unsigned char>(donnees[i])) * premier;
+    }
+    return h ^ taille;
+}
+
+/**
+ * @brief Écrit l'instantané du catalogue.
+ *
+ * Le fichier est d'abord écrit sous un nom temporaire puis renommé, un lancement concurrent ne lit donc jamais
+ * un instantané à moitié écrit.
+ * @param chemin Le chemin de l'instantané.
+ * @param colonnes Le catalogue en colonnes à sauvegarder.
+ * @param sources L'état des fichiers CSV dont il est issu, dans l'ordre des catégories.
+ * @return True si l'instantané a été écrit.
+ */
+bool InstantaneCatalogue::ecrire(const string& chemin, const CatalogueColonnes& colonnes, vector<EtatSource>& sources) {
+    Tampon t;
+    EnTete entete;
+    memcpy(entete.magie, MAGIE, sizeof(MAGIE));
+    entete.version = VERSION;
+    entete.ordre_octets = ORDRE_OCTETS;
+    entete.nbr_sources = static_cast<uint32_t>(sources.size());
+    entete.nbr_colonnes = NBR_COLONNES;
+    entete.nbr_lignes = colonnes.getNbrLignes();
+    entete.somme_contenu = 0;
+    t.ajouterValeur(entete);
+
+    for (auto& s : sources) {
+        EntreeSource e = {s.taille, s.date_modif, s.getSomme()};
+        t.ajouterValeur(e);
+    }
+
+    t.ajouterValeur(static_cast<uint32_t>(colonnes.debut_marques.size()));
+    t.ajouter(colonnes.debut_marques.data(), colonnes.debut_marques.size() * sizeof(uint32_t));
+
+    // La table des colonnes est réservée ici et remplie une fois les positions connues
+    size_t position_table = t.octets.size();
+    t.octets.resize(t.octets.size() + NBR_COLONNES * sizeof(EntreeColonne));
+
+    ecrireDictionnaire(t, colonnes.dico_marques);
+    ecrireDictionnaire(t, colonnes.dico_modeles);
+    ecrireDictionnaire(t, colonnes.dico_boites);
+    ecrireDictionnaire(t, colonnes.dico_essences);
+
+    vector<EntreeColonne> table;
+    ecrireColonne(t, table, COL_ANNEES, TYPE_INT32, colonnes.annees);
+    ecrireColonne(t, table, COL_PRIX, TYPE_FLOAT32, colonnes.prix);
+    ecrireColonne(t, table, COL_KILOMETRES, TYPE_INT32, colonnes.kilometres);
+    ecrireColonne(t, table, COL_TAXES, TYPE_INT32, colonnes.taxes);
+    ecrireColonne(t, table, COL_MPGS, TYPE_FLOAT32, colonnes.mpgs);
+    ecrireColonne(t, table, COL_TAILLES_ENGIN, TYPE_FLOAT32, colonnes.tailles_engin);
+    ecrireColonne(t, table, COL_MARQUES, TYPE_CODE16, colonnes.marques);
+    ecrireColonne(t, table, COL_MODELES, TYPE_CODE16, colonnes.modeles);
+    ecrireColonne(t, table, COL_BOITES, TYPE_CODE16, colonnes.boites);
+    ecrireColonne(t, table, COL_ESSENCES, TYPE_CODE16, colonnes.essences);
+    memcpy(t.octets.data() + position_table, table.data(), table.size() * sizeof(EntreeColonne));
+
+    entete.somme_contenu = sommeControle(t.octets.data() + sizeof(EnTete), t.octets.size() - sizeof(EnTete));
+    memcpy(t.octets.data(), &entete, sizeof(EnTete));
+
+    string temporaire = chemin + ".tmp";
+    {
+        ofstream fichier(temporaire, ios::binary | ios::trunc);
+        if (!fichier.is_open()) {
+            return false;
+        }
+        fichier.write(t.octets.data(), t.octets.size());
+        if (!fichier.good()) {
+            return false;
+        }
+    }
+    std::remove(chemin.c_str());
+    return std::rename(temporaire.c_str(), chemin.c_str()) == 0;
+}
+
+/**
+ * @brief Charge l'instantané s'il correspond encore aux fichiers CSV.
+ * @param chemin Le chemin de l'instantané.
+ * @param colonnes Le catalogue en colonnes à remplir.
+ * @param sources L'état actuel des fichiers CSV, dans l'ordre des catégories.
+ * @param dates_changees Mis à vrai si une date a changé alors que le contenu est identique.
+ * @return True si l'instantané est valide et a été chargé, sinon les colonnes sont laissées vides.
+ */
+bool InstantaneCatalogue::lire(const string& chemin, CatalogueColonnes& colonnes, vector<EtatSource>& sources, bool& dates_changees) {
+    dates_changees = false;
+    ProjectionFichier projection;
+    if (!projection.ouvrir(chemin) || projection.getTaille() < sizeof(EnTete)) {
+        return false;
+    }
+
+    Lecteur l = {projection.getDebut(), projection.getTaille(), 0};
+    EnTete entete;
+    l.lireValeur(entete);
+    if (memcmp(entete.magie, MAGIE, sizeof(MAGIE)) != 0 || entete.version != VERSION
+        || entete.ordre_octets != ORDRE_OCTETS || entete.nbr_sources != sources.size()
+        || entete.nbr_colonnes != NBR_COLONNES) {
+        return false;
+    }
+
+    // Validation des sources avant de lire les colonnes
+    for (auto& s : sources) {
+        EntreeSource e;
+        if (!l.lireValeur(e) || e.taille != s.taille) {
+            return false;
+        }
+        if (e.date_modif != s.date_modif) {
+            if (e.somme != s.getSomme()) {
+                return false;
+            }
+            dates_changees = true;
+        }
+    }
+
+    if (sommeControle(l.debut + sizeof(EnTete), l.taille - sizeof(EnTete)) != entete.somme_contenu) {
+        return false;
+    }
+
+    colonnes.vider();
+    uint32_t nbr_debuts = 0;
+    if (!l.lireValeur(nbr_debuts) || l.pos + nbr_debuts * sizeof(uint32_t) > l.taille) {
+        return false;
+    }
+    colonnes.debut_marques.resize(nbr_debuts);
+    l.lire(colonnes.debut_marques.data(), nbr_debuts * sizeof(uint32_t));
+
+    EntreeColonne table[NBR_COLONNES];
+    if (!l.lire(table, sizeof(table))) {
+        return false;
+    }
+
+    bool ok = lireDictionnaire(l, colonnes.dico_marques)
+        && lireDictionnaire(l, colonnes.dico_modeles)
+        && lireDictionnaire(l, colonnes.dico_boites)
+        && lireDictionnaire(l, colonnes.dico_essences);
+
+    uint64_t n = entete.nbr_lignes;
+    ok = ok
+        && lireColonne(projection, table[COL_ANNEES], TYPE_INT32, n, colonnes.annees)
+        && lireColonne(projection, table[COL_PRIX], TYPE_FLOAT32, n, colonnes.prix)
+        && lireColonne(projection, table[COL_KILOMETRES], TYPE_INT32, n, colonnes.kilometres)
+        && lireColonne(projection, table[COL_TAXES], TYPE_INT32, n, colonnes.taxes)
+        && lireColonne(projection, table[COL_MPGS], TYPE_FLOAT32, n, colonnes.mpgs)
+        && lireColonne(projection, table[COL_TAILLES_ENGIN], TYPE_FLOAT32, n, colonnes.tailles_engin)
+        && lireColonne(projection, table[COL_MARQUES], TYPE_CODE16, n, colonnes.marques)
+        && lireColonne(projection, table[COL_MODELES], TYPE_CODE16, n, colonnes.modeles)
+        && lireColonne(projection, table[COL_BOITES], TYPE_CODE16, n, colonnes.boites)
+        && lireColonne(projection, table[COL_ESSENCES], TYPE_CODE16, n, colonnes.essences);
+
+    if (!ok) {
+        colonnes.vider();
+    }
+    return ok;
+}
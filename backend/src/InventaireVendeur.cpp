@@ -0,0 +1,116 @@
+/**
+ * @file InventaireVendeur.cpp
+ * @brief Implémentation de la classe InventaireVendeur, inventaire d'un vendeur à ajout et retrait en O(1).
+ *
+ * Supprimer un produit cherchait son identifiant dans tout le vecteur puis décalait à la main tous les produits
+ * suivants. L'inventaire est maintenant une "slot map" : chaque produit occupe un emplacement stable, désigné
+ * par une clé (indice, génération), et les produits eux-mêmes restent contigus pour les parcours.
+ *
+ * Un retrait met le dernier produit à la place du produit retiré et rend l'emplacement à la liste libre, avec
+ * une nouvelle génération : une clé gardée sur un produit retiré ne désigne jamais le produit qui réutilise son
+ * emplacement. L'ordre de parcours n'est conservé que tant qu'aucun produit n'est retiré.
+ */
+
+#include "InventaireVendeur.h"
+
+using namespace std;
+
+/**
+ * @brief Ajoute un produit en fin d'inventaire.
+ * @param p Le produit.
+ * @param ligne Sa ligne dans le catalogue en colonnes, -1 s'il est hors catalogue.
+ * @return La clé du produit.
+ */
+InventaireVendeur::Cle InventaireVendeur::ajouter(const shared_ptr<Produit>& p, int ligne) {
+    uint32_t indice;
+    if (!libres.empty()) {
+        indice = libres.back();
+        libres.pop_back();
+    } else {
+        indice = static_cast<uint32_t>(emplacements.size());
+        emplacements.emplace_back();
+    }
+    emplacements[indice].dense = static_cast<uint32_t>(produits.size());
+    produits.push_back(p);
+    lignes.push_back(ligne);
+    emplacement_de.push_back(indice);
+    par_produit[p.get()] = indice;
+    return {indice, emplacements[indice].generation};
+}
+
+/**
+ * @brief Retire le produit d'un emplacement occupé : le dernier produit prend sa place.
+ * @param indice L'indice de l'emplacement.
+ */
+void InventaireVendeur::retirerEmplacement(uint32_t indice) {
+    Emplacement& e = emplacements[indice];
+    uint32_t dernier = static_cast<uint32_t>(produits.size() - 1);
+    par_produit.erase(produits[e.dense].get());
+    if (e.dense != dernier) {
+        produits[e.dense] = move(produits[dernier]);
+        lignes[e.dense] = lignes[dernier];
+        emplacement_de[e.dense] = emplacement_de[dernier];
+        emplacements[emplacement_de[e.dense]].dense = e.dense;
+    }
+    produits.pop_back();
+    lignes.pop_back();
+    emplacement_de.pop_back();
+
+    e.generation++;
+    if (e.generation == 0) {
+        e.generation = 1;       // 0 est réservé à la clé nulle
+    }
+    libres.push_back(indice);
+}
+
+/**
+ * @brief Retire le produit d'une clé.
+ * @param cle La clé.
+ * @return True si un produit a été retiré, false si la clé est nulle ou périmée.
+ */
+bool InventaireVendeur::retirer(Cle cle) {
+    if (cle.generation == 0 || cle.indice >= emplacements.size() || emplacements[cle.indice].generation != cle.generation) {
+        return false;
+    }
+    retirerEmplacement(cle.indice);
+    return true;
+}
+
+/**
+ * @brief Retire un produit de l'inventaire.
+ * @param p Le produit.
+ * @return True si le produit était dans l'inventaire.
+ */
+bool InventaireVendeur::retirer(const Produit* p) {
+    auto it = par_produit.find(p);
+    if (it == par_produit.end()) {
+        return false;
+    }
+    retirerEmplacement(it->second);
+    return true;
+}
+
+/**
+ * @brief Retourne le produit d'une clé.
+ * @param cle La clé.
+ * @return Le produit, ou nullptr si la clé est nulle ou périmée.
+ */
+shared_ptr<Produit> InventaireVendeur::obtenir(Cle cle) const {
+    if (cle.generation == 0 || cle.indice >= emplacements.size() || emplacements[cle.indice].generation != cle.generation) {
+        return nullptr;
+    }
+    return produits[emplacements[cle.indice].dense];
+}
+
+/**
+ * @brief Retourne la clé d'un produit de l'inventaire.
+ * @param p Le produit.
+ * @return Sa clé, nulle s'il n'est pas dans l'inventaire.
+ */
+InventaireVendeur::Cle InventaireVendeur::getCle(const Produit* p) const {
+    auto it = par_produit.find(p);
+    if (it == par_produit.end()) {
+        return {};
+    }
+    return {it->second, emplacements[it->second].generation};
+}
@@ -7,6 +7,11 @@
  * La classe contient des informations sur l'objet de l'offre, l'offre elle-même, le message, ainsi que des identifiants
  * pour l'émetteur et le récepteur. Elle inclut également un produit auquel le message se réfère.
  *
+ * Un message tient sur 32 octets et se copie octet par octet : l'objet est un Verbe au lieu d'une chaîne
+ * ("offer", "search"...) comparée à chaque tour, le produit une poignée et le texte libre un identifiant de
+ * TableChaines. Boîtes aux lettres, acheteurs et vendeurs se passent donc les messages par valeur, sans
+ * allocation ni compteur de références.
+ *
  * @author [Ton Nom]
  * @date [Date]
  */
@@ -16,44 +21,42 @@
 
 using namespace std;
 
+/**
+ * @brief Texte d'un verbe, tel qu'il est affiché.
+ *
+ * @param v Le verbe.
+ * @return "search", "offer", "accept", "break-down", ou une chaîne vide pour Verbe::AUCUN.
+ */
+const string& verbeVersTexte(Verbe v) {
+    static const string textes[] = {"", "search", "offer", "accept", "break-down"};
+    return textes[static_cast<size_t>(v)];
+}
+
 /**
  * @brief Constructeur de la classe Message.
  *
  * Ce constructeur initialise un message avec l'identifiant de l'émetteur, l'identifiant du récepteur,
- * l'objet du message, l'offre associée, le contenu du message, et un produit lié à l'offre.
+ * l'objet du message, l'offre associée, un produit lié à l'offre et le contenu du message.
  *
  * @param id_e Identifiant de l'émetteur du message.
  * @param id_r Identifiant du récepteur du message.
  * @param obj Objet du message.
  * @param offr Offre associée au message.
- * @param mess Contenu du message.
- * @param prod Pointeur partagé vers le produit lié à l'offre.
+ * @param prod Poignée du produit lié à l'offre.
+ * @param mess Contenu du message, interné dans TableChaines s'il n'est pas vide.
  */
-Message::Message(int id_e, int id_r, string obj, float offr, string mess, shared_ptr<Produit> prod)
+Message::Message(int id_e, int id_r, Verbe obj, float offr, PoigneeProduit prod, const string& mess)
+    : id_emmeteur(id_e), id_recepteur(id_r), produit(prod), offre(offr), objet(obj)
 {
-    objet = obj;
-    offre = offr;
-    message = mess;
-    id_emmeteur = id_e;
-    id_recepteur = id_r;
-    produit = prod;
+    setMessage(mess);
 }
 
-/**
- * @brief Destructeur de la classe Message.
- *
- * Ce destructeur libère les ressources allouées par l'objet Message.
- * Dans ce cas, il n'y a pas de gestion particulière, car les membres de la classe sont automatiquement gérés
- * (par exemple, le pointeur partagé `produit` est géré par un `shared_ptr`).
- */
-Message::~Message() {}
-
 /**
  * @brief Modifie l'objet du message.
  *
  * @param obj L'objet à définir pour le message.
  */
-void Message::setObjet(string obj) {
+void Message::setObjet(Verbe obj) {
     objet = obj;
 }
 
@@ -71,8 +74,8 @@ void Message::setOffre(float offr) {
  *
  * @param mess Le texte du message à définir.
  */
-void Message::setMessage(string mess) {
-    message = mess;
+void Message::setMessage(const string& mess) {
+    message = mess.empty() ? TableChaines::VIDE : TableChaines::getInstance().interner(mess);
 }
 
 /**
@@ -96,27 +99,18 @@ void Message::setIdRecep(int idre) {
 /**
  * @brief Modifie le produit lié au message.
  *
- * @param prod Pointeur partagé vers le produit à définir.
+ * @param prod Poignée du produit à définir.
  */
-void Message::setProduit(shared_ptr<Produit> prod) {
+void Message::setProduit(PoigneeProduit prod) {
     produit = prod;
 }
 
-/**
- * @brief Récupère l'objet du message.
- *
- * @return L'objet du message.
- */
-string Message::getObjet() {
-    return objet;
-}
-
 /**
  * @brief Récupère l'offre associée au message.
  *
  * @return L'offre du message.
  */
-float Message::getOffre() {
+float Message::getOffre() const {
     return offre;
 }
 
@@ -125,8 +119,8 @@ float Message::getOffre() {
  *
  * @return Le texte du message.
  */
-string Message::getMessage() {
-    return message;
+const string& Message::getMessage() const {
+    return TableChaines::getInstance().getChaine(message);
 }
 
 /**
@@ -134,7 +128,7 @@ string Message::getMessage() {
  *
  * @return L'identifiant de l'émetteur.
  */
-int Message::getIdEmmeteur() {
+int Message::getIdEmmeteur() const {
     return id_emmeteur;
 }
 
@@ -143,16 +137,27 @@ int Message::getIdEmmeteur() {
  *
  * @return L'identifiant du récepteur.
  */
-int Message::getIdRecep() {
+int Message::getIdRecep() const {
     return id_recepteur;
 }
 
 /**
  * @brief Récupère le produit lié au message.
  *
- * @return Le pointeur partagé vers le produit lié à l'offre.
+ * Le produit est retrouvé dans TableProduits par sa poignée, sans toucher à un compteur de références.
+ *
+ * @return Le produit lié à l'offre, ou nullptr s'il a été libéré depuis.
+ */
+Produit* Message::getProduit() const {
+    return TableProduits::getInstance().obtenir(produit);
+}
+
+/**
+ * @brief Récupère la poignée du produit lié au message.
+ *
+ * @return La poignée du produit, à reprendre telle quelle dans la réponse.
  */
-shared_ptr<Produit> Message::getProduit() {
+PoigneeProduit Message::getPoigneeProduit() const {
     return produit;
 }
 
@@ -162,11 +167,12 @@ shared_ptr<Produit> Message::getProduit() {
  * Cette méthode affiche les informations complètes du message, y compris les identifiants des émetteurs et récepteurs,
  * l'objet du message, l'offre, le produit lié, et le contenu du message.
  */
-void Message::afficherMessage() {
+void Message::afficherMessage() const {
     cout << "ID Emetteur: " << id_emmeteur << endl;
     cout << "ID Recepteur: " << id_recepteur << endl;
-    cout << "Objet: " << objet << endl;
-    cout << "ID Produit: " << produit->getId() << endl;
+    cout << "Objet: " << verbeVersTexte(objet) << endl;
+    Produit* p = getProduit();
+    cout << "ID Produit: " << (p != nullptr ? p->getId() : -1) << endl;
     cout << "Offre: " << offre << endl << endl;
     cout << "Message: " << message << endl << endl;
     cout << "-----------------------------------------------------------------------------------------" << endl;
@@ -0,0 +1,108 @@
+/**
+ * @file Negociation.cpp
+ * @brief Implémentation de la classe Negociation, coroutine d'un acheteur ou d'un vendeur.
+ *
+ * Acheteur::negocier et Vendeur::negocier étaient des automates écrits à la main : chaque attente était une
+ * étape, et toutes les variables locales étaient copiées dans une structure de l'agent pour survivre d'une
+ * reprise à l'autre. Ce sont maintenant des coroutines : le code garde la forme d'une fonction suivie, chaque
+ * attente est un co_await sur l'événement de l'agent, et les variables restent dans le cadre de la coroutine.
+ *
+ * Une négociation suspendue ne coûte que son cadre, quelques centaines d'octets sur le tas, au lieu de la pile
+ * d'un thread. Les reprises sont des tâches de l'Ordonnanceur.
+ *
+ * L'ancienne exécution reste disponible pour comparer (Execution::THREADS) : chaque négociation tourne alors
+ * sur un thread à elle, et chaque co_await sur son Evenement bloque ce thread sur une variable de condition au
+ * lieu de suspendre la coroutine. Le code des agents est le même dans les deux modes.
+ */
+
+#include "Negociation.h"
+
+using namespace std;
+
+atomic<Negociation::Execution> Negociation::mode(Negociation::Execution::ORDONNANCEUR);
+
+/**
+ * @brief Dernière suspension de la coroutine : appelle la fonction de fin.
+ *
+ * La fonction est d'abord sortie du cadre : le propriétaire peut détruire la négociation dès qu'elle est appelée.
+ *
+ * @param h La coroutine qui se termine.
+ */
+void Negociation::Fin::await_suspend(coroutine_handle<promise_type> h) noexcept {
+    function<void()> fin = move(h.promise().fin);
+    if (fin) {
+        fin();
+    }
+}
+
+/**
+ * @brief Constructeur de déplacement, la négociation déplacée ne possède plus de cadre.
+ * @param autre La négociation déplacée.
+ */
+Negociation::Negociation(Negociation&& autre) noexcept : poignee(autre.poignee), execution(move(autre.execution)) {
+    autre.poignee = nullptr;
+}
+
+/**
+ * @brief Affectation par déplacement, détruit le cadre possédé avant.
+ * @param autre La négociation déplacée.
+ * @return Cette négociation.
+ */
+Negociation& Negociation::operator=(Negociation&& autre) noexcept {
+    if (this != &autre) {
+        if (execution.joinable()) {
+            execution.join();
+        }
+        if (poignee) {
+            poignee.destroy();
+        }
+        poignee = autre.poignee;
+        autre.poignee = nullptr;
+        execution = move(autre.execution);
+    }
+    return *this;
+}
+
+/**
+ * @brief Destructeur, attend le thread de la négociation s'il y en a un, puis libère le cadre de la coroutine.
+ */
+Negociation::~Negociation() {
+    if (execution.joinable()) {
+        execution.join();
+    }
+    if (poignee) {
+        poignee.destroy();
+    }
+}
+
+/**
+ * @brief Lance la négociation : elle s'exécute sur le thread appelant jusqu'à sa première attente.
+ *
+ * En mode THREADS, elle s'exécute en entier sur un nouveau thread, et demarrer retourne aussitôt.
+ * @param fin Appelée quand la négociation se termine, sur le thread qui l'exécute alors.
+ */
+void Negociation::demarrer(function<void()> fin) {
+    poignee.promise().fin = move(fin);
+    if (getExecution() == Execution::THREADS) {
+        coroutine_handle<promise_type> h = poignee;
+        execution = thread([h] { h.resume(); });
+        return;
+    }
+    poignee.resume();
+}
+
+/**
+ * @brief Choisit comment les négociations suivantes s'exécutent.
+ * @param e ORDONNANCEUR (coroutines reprises par le pool) ou THREADS (un thread bloquant par agent).
+ */
+void Negociation::setExecution(Execution e) {
+    mode.store(e);
+}
+
+/**
+ * @brief Indique comment les négociations s'exécutent.
+ * @return Le mode d'exécution.
+ */
+Negociation::Execution Negociation::getExecution() {
+    return mode.load(memory_order_relaxed);
+}
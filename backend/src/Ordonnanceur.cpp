@@ -0,0 +1,182 @@
+/**
+ * @file Ordonnanceur.cpp
+ * @brief Implémentation de la classe Ordonnanceur, pool de threads à vol de tâches.
+ *
+ * start_negocier lançait un thread par acheteur et par vendeur, presque tous bloqués sur leur variable de
+ * condition. Avec quelques centaines de vendeurs, cela faisait autant de threads noyau et de changements de
+ * contexte. Les agents sont maintenant des tâches d'un pool de taille fixe, un thread par cœur, créé une fois
+ * pour toute l'application : le nombre de threads ne dépend plus du nombre d'agents.
+ *
+ * Chaque travailleur a sa file. Une tâche soumise depuis un travailleur va dans sa propre file : le vendeur
+ * réveillé par un acheteur tourne sur le même cœur, avec les messages encore en cache. Un travailleur sans tâche
+ * vole dans une autre file, puis s'endort jusqu'à la prochaine soumission.
+ *
+ * Les files sont prises dans l'ordre des soumissions, pas en pile : les agents sont repris dans l'ordre où leurs
+ * messages sont arrivés, et une reprise ne reste pas derrière toutes les tâches soumises après elle.
+ *
+ * Les tâches différées (délai d'une recherche) attendent leur échéance dans le thread minuteur, qui ne fait que
+ * les soumettre au pool : aucun travailleur ne dort en attendant un délai.
+ */
+
+#include "Ordonnanceur.h"
+
+using namespace std;
+
+thread_local int Ordonnanceur::indice_courant = -1;
+
+/**
+ * @brief Constructeur privé, lance les travailleurs.
+ * @param nbr_travailleurs Le nombre de threads du pool, au moins un.
+ */
+Ordonnanceur::Ordonnanceur(size_t nbr_travailleurs)
+    : suivante(0), en_attente(0), arret(false), arret_minuteur(false) {
+    if (nbr_travailleurs == 0) {
+        nbr_travailleurs = 1;
+    }
+    for (size_t i = 0; i < nbr_travailleurs; i++) {
+        files.push_back(make_unique<File>());
+    }
+    for (size_t i = 0; i < nbr_travailleurs; i++) {
+        travailleurs.emplace_back(&Ordonnanceur::travailler, this, i);
+    }
+    minuteur = thread(&Ordonnanceur::minuter, this);
+}
+
+/**
+ * @brief Destructeur, termine les tâches en attente puis arrête les travailleurs.
+ *
+ * Les tâches différées pas encore échues sont abandonnées.
+ */
+Ordonnanceur::~Ordonnanceur() {
+    {
+        lock_guard<mutex> lock(mtx_minuteur);
+        arret_minuteur = true;
+    }
+    cv_minuteur.notify_one();
+    minuteur.join();
+    {
+        lock_guard<mutex> lock(mtx_sommeil);
+        arret = true;
+    }
+    cv_sommeil.notify_all();
+    for (thread& t : travailleurs) {
+        t.join();
+    }
+}
+
+/**
+ * @brief Retourne le pool partagé, un travailleur par cœur.
+ * @return L'instance unique de l'ordonnanceur.
+ */
+Ordonnanceur& Ordonnanceur::getInstance() {
+    static Ordonnanceur instance(thread::hardware_concurrency());
+    return instance;
+}
+
+/**
+ * @brief Soumet une tâche au pool.
+ *
+ * Depuis un travailleur, la tâche va dans sa propre file ; depuis un autre thread, dans les files à tour de rôle.
+ *
+ * @param tache La tâche, qui ne doit pas bloquer.
+ */
+void Ordonnanceur::soumettre(Tache tache) {
+    size_t indice = indice_courant >= 0 ? static_cast<size_t>(indice_courant) : suivante++ % files.size();
+    {
+        lock_guard<mutex> lock(files[indice]->mtx);
+        files[indice]->taches.push_back(move(tache));
+    }
+    {
+        lock_guard<mutex> lock(mtx_sommeil);
+        en_attente++;
+    }
+    cv_sommeil.notify_one();
+}
+
+/**
+ * @brief Soumet une tâche au pool après un délai.
+ * @param delai Le délai avant la soumission.
+ * @param tache La tâche, qui ne doit pas bloquer.
+ */
+void Ordonnanceur::soumettreApres(chrono::milliseconds delai, Tache tache) {
+    {
+        lock_guard<mutex> lock(mtx_minuteur);
+        echeances.emplace(chrono::steady_clock::now() + delai, move(tache));
+    }
+    cv_minuteur.notify_one();
+}
+
+/**
+ * @brief Prend la plus ancienne tâche de sa propre file, sinon celle d'une autre file.
+ * @param indice L'indice du travailleur.
+ * @param tache Reçoit la tâche prise.
+ * @return True si une tâche a été prise.
+ */
+bool Ordonnanceur::prendre(size_t indice, Tache& tache) {
+    {
+        File& f = *files[indice];
+        lock_guard<mutex> lock(f.mtx);
+        if (!f.taches.empty()) {
+            tache = move(f.taches.front());
+            f.taches.pop_front();
+            en_attente--;
+            return true;
+        }
+    }
+    for (size_t k = 1; k < files.size(); k++) {
+        File& f = *files[(indice + k) % files.size()];
+        lock_guard<mutex> lock(f.mtx);
+        if (!f.taches.empty()) {
+            tache = move(f.taches.front());
+            f.taches.pop_front();
+            en_attente--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Boucle d'un travailleur : exécute les tâches, vole, ou dort en attendant une soumission.
+ * @param indice L'indice du travailleur.
+ */
+void Ordonnanceur::travailler(size_t indice) {
+    indice_courant = static_cast<int>(indice);
+    Tache tache;
+    while (true) {
+        if (prendre(indice, tache)) {
+            tache();
+            tache = nullptr;
+            continue;
+        }
+        unique_lock<mutex> lock(mtx_sommeil);
+        cv_sommeil.wait(lock, [this] { return arret || en_attente.load() > 0; });
+        if (arret && en_attente.load() <= 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Boucle du minuteur : soumet chaque tâche différée à son échéance.
+ */
+void Ordonnanceur::minuter() {
+    unique_lock<mutex> lock(mtx_minuteur);
+    while (!arret_minuteur) {
+        if (echeances.empty()) {
+            cv_minuteur.wait(lock);
+            continue;
+        }
+        auto premiere = echeances.begin();
+        chrono::steady_clock::time_point echeance = premiere->first;
+        if (chrono::steady_clock::now() < echeance) {
+            cv_minuteur.wait_until(lock, echeance);
+            continue;
+        }
+        Tache tache = move(premiere->second);
+        echeances.erase(premiere);
+        lock.unlock();
+        soumettre(move(tache));
+        lock.lock();
+    }
+}
@@ -4,11 +4,19 @@
  */
 
 #include "Produit.h"
+#include "Voiture.h"
 #include <iostream>
 #include <string>
+#include <atomic>
 
 using namespace std;
 
+namespace {
+
+atomic<int> prochain_identifiant(1);
+
+}
+
 /**
  * @brief Destructeur de la classe Produit.
  */
@@ -24,18 +32,29 @@ string Produit::getDescription() const {
 
 /**
  * @brief Récupère le prix du produit.
+ *
+ * Si le facteur de l'échelle du vendeur a changé depuis que le prix a été fixé, le prix est multiplié par le
+ * rapport des deux facteurs.
+ *
  * @return Le prix du produit.
  */
 float Produit::getPrix() const {
-    return this->prix;
+    if (echelle == nullptr) {
+        return this->prix;
+    }
+    double facteur = echelle->getFacteur();
+    if (facteur == facteur_ref) {
+        return this->prix;
+    }
+    return static_cast<float>(this->prix * (facteur / facteur_ref));
 }
 
 /**
  * @brief Récupère la catégorie du produit.
  * @return La catégorie du produit.
  */
-string Produit::getCategorie() const {
-    return this->categorie;
+const string& Produit::getCategorie() const {
+    return TableChaines::getInstance().getChaine(this->categorie);
 }
 
 /**
@@ -84,6 +103,21 @@ void Produit::setDescription(const string & description) {
  */
 void Produit::setPrix(const float prix) {
     this->prix = prix;
+    facteur_ref = echelle != nullptr ? echelle->getFacteur() : 1.0;
+}
+
+/**
+ * @brief Rattache le produit à l'échelle de prix de son vendeur.
+ *
+ * Le prix actuel, augmentations de l'ancienne échelle comprises, devient le prix de référence : le rattacher
+ * puis le détacher (figerPrix) ne change pas son prix.
+ *
+ * @param e L'échelle, ou nullptr pour détacher le produit.
+ */
+void Produit::setEchelle(shared_ptr<const EchellePrix> e) {
+    float actuel = getPrix();
+    echelle = move(e);
+    setPrix(actuel);
 }
 
 /**
@@ -91,7 +125,7 @@ void Produit::setPrix(const float prix) {
  * @param categorie La catégorie à définir.
  */
 void Produit::setCategorie(const string& categorie) {
-    this->categorie = categorie;
+    this->categorie = TableChaines::getInstance().interner(categorie);
 }
 
 /**
@@ -111,12 +145,39 @@ void Produit::setId(int idx) {
 }
 
 /**
- * @brief Affiche les détails du produit.
- * Cette fonction affiche l'ID, la catégorie, la description et le prix du produit.
+ * @brief Donne un identifiant d'annonce jamais encore utilisé pendant la session.
+ *
+ * Deux vendeurs peuvent tirer la même ligne du catalogue : l'identifiant d'une annonce ne vient donc pas de la
+ * ligne, qui reste gardée à part dans l'inventaire du vendeur.
+ * @return L'identifiant, à partir de 1.
+ */
+int Produit::nouvelIdentifiant() {
+    return prochain_identifiant.fetch_add(1, memory_order_relaxed);
+}
+
+/**
+ * @brief Affiche les détails du produit, selon son type.
+ *
+ * Remplace la fonction virtuelle : le type du produit indique quelle classe l'affiche.
  */
 void Produit::afficherTout() const {
+    switch (type) {
+    case TypeProduit::VOITURE:
+        static_cast<const Voiture*>(this)->afficherTout();
+        break;
+    default:
+        afficherCommun();
+        break;
+    }
+}
+
+/**
+ * @brief Affiche les détails communs à tous les produits.
+ * Cette fonction affiche l'ID, la catégorie, la description et le prix du produit.
+ */
+void Produit::afficherCommun() const {
     cout << "ID: " << id << endl;
-    cout << "Catégorie: " << categorie << endl;
+    cout << "Catégorie: " << getCategorie() << endl;
     cout << "Description: " << description << endl;
-    cout << "Prix: " << prix << "€" << endl << endl;
+    cout << "Prix: " << getPrix() << "€" << endl << endl;
 }
@@ -0,0 +1,141 @@
+/**
+ * @file ProjectionFichier.cpp
+ * @brief Implémentation de la classe ProjectionFichier, projection d'un fichier en mémoire (mmap / MapViewOfFile).
+ */
+
+#include "ProjectionFichier.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief Constructeur d'une projection vide.
+ */
+ProjectionFichier::ProjectionFichier() : debut(nullptr), taille(0)
+#ifdef _WIN32
+    , fichier_win(nullptr), projection_win(nullptr)
+#endif
+{}
+
+/**
+ * @brief Destructeur, libère la projection.
+ */
+ProjectionFichier::~ProjectionFichier() {
+    fermer();
+}
+
+/**
+ * @brief Constructeur par déplacement, la projection change de propriétaire.
+ * @param autre La projection à déplacer.
+ */
+ProjectionFichier::ProjectionFichier(ProjectionFichier&& autre) noexcept : ProjectionFichier() {
+    *this = std::move(autre);
+}
+
+/**
+ * @brief Affectation par déplacement.
+ * @param autre La projection à déplacer.
+ * @return Cette projection.
+ */
+ProjectionFichier& ProjectionFichier::operator=(ProjectionFichier&& autre) noexcept {
+    if (this != &autre) {
+        fermer();
+        debut = std::exchange(autre.debut, nullptr);
+        taille = std::exchange(autre.taille, 0);
+#ifdef _WIN32
+        fichier_win = std::exchange(autre.fichier_win, nullptr);
+        projection_win = std::exchange(autre.projection_win, nullptr);
+#endif
+    }
+    return *this;
+}
+
+/**
+ * @brief Projette un fichier en mémoire en lecture seule.
+ * @param chemin Le chemin du fichier.
+ * @return True si le fichier a pu être projeté.
+ */
+bool ProjectionFichier::ouvrir(const string& chemin) {
+    fermer();
+#ifdef _WIN32
+    HANDLE fichier = CreateFileA(chemin.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fichier == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    fichier_win = fichier;
+    LARGE_INTEGER t;
+    GetFileSizeEx(fichier, &t);
+    taille = static_cast<size_t>(t.QuadPart);
+    if (taille == 0) {
+        return true;
+    }
+    HANDLE projection = CreateFileMappingA(fichier, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (projection == nullptr) {
+        fermer();
+        return false;
+    }
+    projection_win = projection;
+    debut = static_cast<const char*>(MapViewOfFile(projection, FILE_MAP_READ, 0, 0, 0));
+    if (debut == nullptr) {
+        fermer();
+        return false;
+    }
+#else
+    int fd = open(chemin.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat infos;
+    if (fstat(fd, &infos) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t t = static_cast<size_t>(infos.st_size);
+    if (t > 0) {
+        void* adresse = mmap(nullptr, t, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (adresse == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        madvise(adresse, t, MADV_WILLNEED);
+        debut = static_cast<const char*>(adresse);
+    }
+    taille = t;
+    close(fd);
+#endif
+    return true;
+}
+
+/**
+ * @brief Libère la projection et ferme le fichier.
+ */
+void ProjectionFichier::fermer() {
+#ifdef _WIN32
+    if (debut) {
+        UnmapViewOfFile(debut);
+    }
+    if (projection_win) {
+        CloseHandle(projection_win);
+    }
+    if (fichier_win) {
+        CloseHandle(fichier_win);
+    }
+    projection_win = nullptr;
+    fichier_win = nullptr;
+#else
+    if (debut) {
+        munmap(const_cast<char*>(debut), taille);
+    }
+#endif
+    debut = nullptr;
+    taille = 0;
+}
@@ -11,7 +11,8 @@
  * Initialise les valeurs des paramètres du protocole à zéro ou à leur valeur par défaut.
  */
 Protocol::Protocol()
-    : nbr_tours(0), nbr_obl_achet(0), penalité(0), neg_meme_temps(0), differer(false) {}
+    : nbr_tours(0), nbr_obl_achet(0), penalité(0), neg_meme_temps(0), differer(false), acheteurs_simultanes(false),
+      offres_suffisantes(0), delai_recherche(0), capacite_vendeur(1) {}
 
 // Implémentations des getters et setters
 
@@ -99,3 +100,71 @@ bool Protocol::isDifferer() const {
 void Protocol::setDifferer(bool value) {
     differer = value;
 }
+
+// acheteurs_simultanes
+/**
+ * @brief Indique si tous les acheteurs négocient en même temps.
+ * @return Vrai si les acheteurs négocient en même temps, faux s'ils négocient l'un après l'autre.
+ */
+bool Protocol::isAcheteursSimultanes() const {
+    return acheteurs_simultanes;
+}
+
+/**
+ * @brief Définit si tous les acheteurs négocient en même temps.
+ * @param value La valeur à définir pour l'attribut `acheteurs_simultanes`.
+ */
+void Protocol::setAcheteursSimultanes(bool value) {
+    acheteurs_simultanes = value;
+}
+
+// offres_suffisantes
+/**
+ * @brief Récupère le nombre d'offres après lequel un acheteur n'attend plus les autres réponses à sa recherche.
+ * @return Le nombre d'offres suffisantes, 0 si l'acheteur attend toutes les réponses.
+ */
+int Protocol::getOffresSuffisantes() const {
+    return offres_suffisantes;
+}
+
+/**
+ * @brief Définit le nombre d'offres après lequel un acheteur n'attend plus les autres réponses à sa recherche.
+ * @param value Le nombre d'offres suffisantes, 0 pour attendre toutes les réponses.
+ */
+void Protocol::setOffresSuffisantes(int value) {
+    offres_suffisantes = value;
+}
+
+// delai_recherche
+/**
+ * @brief Récupère le délai d'attente des réponses à une recherche.
+ * @return Le délai en millisecondes, 0 s'il n'y en a pas.
+ */
+int Protocol::getDelaiRecherche() const {
+    return delai_recherche;
+}
+
+/**
+ * @brief Définit le délai d'attente des réponses à une recherche.
+ * @param value Le délai en millisecondes, 0 pour attendre sans limite.
+ */
+void Protocol::setDelaiRecherche(int value) {
+    delai_recherche = value;
+}
+
+// capacite_vendeur
+/**
+ * @brief Récupère le nombre de négociations qu'un vendeur peut mener en même temps.
+ * @return La capacité d'un vendeur.
+ */
+int Protocol::getCapaciteVendeur() const {
+    return capacite_vendeur;
+}
+
+/**
+ * @brief Définit le nombre de négociations qu'un vendeur peut mener en même temps.
+ * @param value La capacité, ramenée à 1 si elle est plus petite.
+ */
+void Protocol::setCapaciteVendeur(int value) {
+    capacite_vendeur = value < 1 ? 1 : value;
+}
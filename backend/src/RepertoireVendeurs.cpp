@@ -0,0 +1,148 @@
+/**
+ * @file RepertoireVendeurs.cpp
+ * @brief Implémentation de la classe RepertoireVendeurs, annuaire des vendeurs par (marque, modèle).
+ *
+ * Sans répertoire, chaque acheteur envoie une recherche à tous les vendeurs, qui la traitent tous même s'ils
+ * n'ont aucune voiture de la marque demandée. Le répertoire indique quels vendeurs possèdent au moins un produit
+ * d'une marque et d'un modèle : l'acheteur n'écrit qu'à ceux-là, et les autres sont considérés comme ayant
+ * répondu "break-down" sans qu'aucun message ne soit échangé.
+ *
+ * Les listes de vendeurs sont exactes : un filtre de Bloom n'apporterait rien ici, le nombre de couples
+ * (marque, modèle) du catalogue étant de quelques centaines. Le répertoire est reconstruit au début de chaque
+ * négociation et consulté sans verrou pendant celle-ci. Un vendeur qui a vendu sa dernière voiture d'un modèle
+ * entre-temps reste candidat : il répond "break-down".
+ */
+
+#include "RepertoireVendeurs.h"
+#include "Vendeur.h"
+#include "Voiture.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace std;
+
+/**
+ * @brief Constructeur privé, le répertoire est un singleton.
+ */
+RepertoireVendeurs::RepertoireVendeurs()
+    : nbr_vendeurs(0), recherches_envoyees(0), recherches_evitees(0) {}
+
+/**
+ * @brief Retourne l'instance unique du répertoire.
+ * @return Le répertoire partagé par tous les acheteurs et vendeurs.
+ */
+RepertoireVendeurs& RepertoireVendeurs::getInstance() {
+    static RepertoireVendeurs instance;
+    return instance;
+}
+
+/**
+ * @brief Ajoute un vendeur à une liste, une seule fois.
+ *
+ * Les vendeurs sont parcourus par indice croissant : il suffit de comparer au dernier ajouté.
+ * @param vendeurs La liste, triée.
+ * @param v L'indice du vendeur.
+ */
+void RepertoireVendeurs::ajouterVendeur(vector<int>& vendeurs, int v) {
+    if (vendeurs.empty() || vendeurs.back() != v) {
+        vendeurs.push_back(v);
+    }
+}
+
+/**
+ * @brief Reconstruit le répertoire à partir des inventaires des vendeurs.
+ *
+ * Doit être appelée avant le lancement des threads de négociation.
+ * @param vendeurs Les vendeurs, dont l'indice est celui de leur boîte aux lettres chez les acheteurs.
+ */
+void RepertoireVendeurs::construire(const vector<Vendeur>& vendeurs) {
+    nbr_vendeurs = static_cast<int>(vendeurs.size());
+    par_marque_modele.clear();
+    par_marque.clear();
+    par_id.clear();
+    recherches_envoyees = 0;
+    recherches_evitees = 0;
+
+    for (int v = 0; v < nbr_vendeurs; v++) {
+        for (const shared_ptr<Produit>& p : vendeurs[v].getProduits()) {
+            ajouterVendeur(par_id[p->getId()], v);
+            if (const Voiture* voit = commeVoiture(p.get())) {
+                uint64_t cle = (static_cast<uint64_t>(voit->getIdBrand()) << 32) | voit->getIdModel();
+                ajouterVendeur(par_marque_modele[cle], v);
+                ajouterVendeur(par_marque[voit->getIdBrand()], v);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Calcule les vendeurs qui peuvent répondre à une recherche.
+ *
+ * Comme dans Vendeur::chercherProduit, un vendeur possédant un produit de même identifiant est toujours
+ * candidat. Sinon la marque et le modèle, s'ils sont précisés, restreignent les vendeurs ; une recherche sans
+ * marque est envoyée à tous.
+ * @param recherche La voiture recherchée.
+ * @return Les indices des vendeurs candidats, par ordre croissant.
+ */
+vector<int> RepertoireVendeurs::candidats(const Voiture& recherche) const {
+    vector<int> resultat;
+    const vector<int>* attributs = nullptr;
+    bool tous = false;
+
+    if (recherche.getIdBrand() == TableChaines::VIDE) {
+        tous = true;
+    } else if (recherche.getIdModel() == TableChaines::VIDE) {
+        auto it = par_marque.find(recherche.getIdBrand());
+        attributs = it == par_marque.end() ? nullptr : &it->second;
+    } else {
+        uint64_t cle = (static_cast<uint64_t>(recherche.getIdBrand()) << 32) | recherche.getIdModel();
+        auto it = par_marque_modele.find(cle);
+        attributs = it == par_marque_modele.end() ? nullptr : &it->second;
+    }
+
+    if (tous) {
+        resultat.resize(nbr_vendeurs);
+        for (int v = 0; v < nbr_vendeurs; v++) {
+            resultat[v] = v;
+        }
+        return resultat;
+    }
+
+    auto meme_id = par_id.find(recherche.getId());
+    if (meme_id == par_id.end()) {
+        if (attributs != nullptr) {
+            resultat = *attributs;
+        }
+    } else if (attributs == nullptr) {
+        resultat = meme_id->second;
+    } else {
+        set_union(attributs->begin(), attributs->end(), meme_id->second.begin(), meme_id->second.end(),
+                  back_inserter(resultat));
+    }
+    return resultat;
+}
+
+/**
+ * @brief Compte une recherche d'acheteur.
+ * @param envoyees Le nombre de vendeurs auxquels elle a été envoyée.
+ */
+void RepertoireVendeurs::compterRecherche(int envoyees) {
+    recherches_envoyees += envoyees;
+    recherches_evitees += nbr_vendeurs - envoyees;
+}
+
+/**
+ * @brief Récupère le nombre de messages "search" envoyés depuis la dernière construction.
+ * @return Le nombre de recherches envoyées.
+ */
+long RepertoireVendeurs::getRecherchesEnvoyees() const {
+    return recherches_envoyees;
+}
+
+/**
+ * @brief Récupère le nombre de messages "search" évités grâce au répertoire.
+ * @return Le nombre de vendeurs non contactés, cumulé sur les acheteurs.
+ */
+long RepertoireVendeurs::getRecherchesEvitees() const {
+    return recherches_evitees;
+}
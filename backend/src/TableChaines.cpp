@@ -0,0 +1,80 @@
+/**
+ * @file TableChaines.cpp
+ * @brief Implémentation de la classe TableChaines, internement global des chaînes répétées.
+ *
+ * Les marques, modèles, boîtes de vitesses et carburants ne prennent que quelques centaines de valeurs. Chaque
+ * valeur est stockée une seule fois et les voitures ne gardent que son identifiant sur 32 bits. Les chaînes ne
+ * sont relues qu'aux frontières de l'application (interface, affichage console).
+ *
+ * La table ne fait que grandir : une chaîne internée n'est jamais libérée, ce qui garantit la validité des
+ * références retournées par getChaine. Les lectures prennent un verrou partagé, seul l'ajout d'une nouvelle
+ * chaîne prend le verrou exclusif.
+ */
+
+#include "TableChaines.h"
+#include <mutex>
+
+using namespace std;
+
+/**
+ * @brief Constructeur privé, la table est un singleton. La chaîne vide reçoit l'identifiant 0.
+ */
+TableChaines::TableChaines() {
+    chaines.emplace_back();
+    ids.emplace(string_view(chaines.back()), VIDE);
+}
+
+/**
+ * @brief Retourne l'instance unique de la table.
+ * @return La table partagée par toute l'application.
+ */
+TableChaines& TableChaines::getInstance() {
+    static TableChaines instance;
+    return instance;
+}
+
+/**
+ * @brief Retourne l'identifiant d'une chaîne, en l'ajoutant à la table si elle est absente.
+ * @param chaine La chaîne à interner.
+ * @return Son identifiant.
+ */
+IdChaine TableChaines::interner(string_view chaine) {
+    {
+        shared_lock<shared_mutex> lecture(mtx);
+        auto it = ids.find(chaine);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+    unique_lock<shared_mutex> ecriture(mtx);
+    auto it = ids.find(chaine);     // Ajoutée entre-temps par un autre thread
+    if (it != ids.end()) {
+        return it->second;
+    }
+    IdChaine id = static_cast<IdChaine>(chaines.size());
+    chaines.emplace_back(chaine);
+    ids.emplace(string_view(chaines.back()), id);
+    return id;
+}
+
+/**
+ * @brief Retourne la chaîne d'un identifiant.
+ * @param id L'identifiant retourné par interner.
+ * @return La chaîne, vide si l'identifiant est inconnu.
+ */
+const string& TableChaines::getChaine(IdChaine id) const {
+    shared_lock<shared_mutex> lecture(mtx);
+    if (id >= chaines.size()) {
+        return chaines.front();
+    }
+    return chaines[id];
+}
+
+/**
+ * @brief Récupère le nombre de chaînes distinctes, chaîne vide comprise.
+ * @return La taille de la table.
+ */
+size_t TableChaines::getTaille() const {
+    shared_lock<shared_mutex> lecture(mtx);
+    return chaines.size();
+}
@@ -0,0 +1,172 @@
+/**
+ * @file TableProduits.cpp
+ * @brief Implémentation de la classe TableProduits, table centrale des produits référencés par poignée.
+ *
+ * Les messages, les acheteurs, le garage et le panier ne gardent plus de shared_ptr sur les produits mais une
+ * poignée de 8 octets (indice, génération). Pendant la négociation, chaque message créé ou lu ne fait donc plus
+ * d'incrément ni de décrément atomique du compteur de références : obtenir se limite à une lecture atomique de
+ * la génération de l'emplacement.
+ *
+ * Les emplacements sont rangés dans des blocs de taille fixe qui ne sont jamais déplacés, ce qui permet de lire
+ * sans verrou pendant qu'un autre thread enregistre un produit. Libérer un emplacement change sa génération :
+ * les poignées encore en circulation deviennent périmées et obtenir retourne nullptr au lieu d'un produit
+ * détruit ou remplacé. Un produit ne doit pas être libéré pendant une négociation qui l'utilise ; les
+ * libérations se font entre deux sessions (renouvellement des vendeurs, nouveau panier, vente d'une voiture).
+ */
+
+#include "TableProduits.h"
+#include "Produit.h"
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Constructeur privé, la table est un singleton.
+ */
+TableProduits::TableProduits() : nbr_emplacements(0), nbr_vivants(0) {
+    for (atomic<Bloc*>& b : blocs) {
+        b.store(nullptr, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destructeur, libère les blocs et les produits qu'ils gardent encore.
+ */
+TableProduits::~TableProduits() {
+    for (atomic<Bloc*>& b : blocs) {
+        delete b.load(memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Retourne l'instance unique de la table.
+ * @return La table partagée par toute l'application.
+ */
+TableProduits& TableProduits::getInstance() {
+    static TableProduits instance;
+    return instance;
+}
+
+/**
+ * @brief Retourne l'emplacement d'un indice déjà attribué.
+ * @param indice L'indice de l'emplacement.
+ * @return L'emplacement.
+ */
+TableProduits::Emplacement* TableProduits::emplacement(uint32_t indice) const {
+    Bloc* bloc = blocs[indice / TAILLE_BLOC].load(memory_order_acquire);
+    return &(*bloc)[indice % TAILLE_BLOC];
+}
+
+/**
+ * @brief Enregistre un produit et retourne sa poignée.
+ *
+ * Un emplacement libéré est réutilisé avec sa nouvelle génération. Le produit garde la première poignée
+ * encore valide qui le désigne (Produit::getPoignee), pour que ses messages puissent y faire référence.
+ *
+ * @param p Le produit, gardé par la table jusqu'à sa libération.
+ * @return La poignée du produit, nulle si p est nul ou si la table est pleine.
+ */
+PoigneeProduit TableProduits::enregistrer(const shared_ptr<Produit>& p) {
+    PoigneeProduit poignee;
+    if (p == nullptr) {
+        return poignee;
+    }
+    lock_guard<mutex> lock(mtx);
+    uint32_t indice;
+    if (!libres.empty()) {
+        indice = libres.back();
+        libres.pop_back();
+    } else {
+        indice = nbr_emplacements.load(memory_order_relaxed);
+        if (indice / TAILLE_BLOC >= NBR_BLOCS_MAX) {
+            cerr << "TableProduits: table pleine, produit " << p->getId() << " non enregistre" << endl;
+            return poignee;
+        }
+        if (indice % TAILLE_BLOC == 0) {
+            blocs[indice / TAILLE_BLOC].store(new Bloc(), memory_order_release);
+        }
+    }
+
+    Emplacement* e = emplacement(indice);
+    e->produit = p;
+    e->brut = p.get();
+    poignee.indice = indice;
+    poignee.generation = e->generation.load(memory_order_relaxed);
+    if (indice == nbr_emplacements.load(memory_order_relaxed)) {
+        nbr_emplacements.store(indice + 1, memory_order_release);
+    }
+    nbr_vivants++;
+
+    PoigneeProduit actuelle = p->getPoignee();
+    if (actuelle.estNulle() || actuelle.indice >= nbr_emplacements.load(memory_order_relaxed)
+        || emplacement(actuelle.indice)->generation.load(memory_order_relaxed) != actuelle.generation
+        || emplacement(actuelle.indice)->brut != p.get()) {
+        p->setPoignee(poignee);
+    }
+    return poignee;
+}
+
+/**
+ * @brief Libère l'emplacement d'une poignée. Les poignées qui le désignent deviennent périmées.
+ * @param poignee La poignée à libérer, ignorée si elle est nulle ou déjà périmée.
+ */
+void TableProduits::liberer(PoigneeProduit poignee) {
+    shared_ptr<Produit> ancien;     // Détruit hors du verrou
+    {
+        lock_guard<mutex> lock(mtx);
+        if (poignee.estNulle() || poignee.indice >= nbr_emplacements.load(memory_order_relaxed)) {
+            return;
+        }
+        Emplacement* e = emplacement(poignee.indice);
+        if (e->generation.load(memory_order_relaxed) != poignee.generation) {
+            return;
+        }
+        uint32_t generation = poignee.generation + 1;
+        if (generation == 0) {
+            generation = 1;         // 0 est réservé à la poignée nulle
+        }
+        e->generation.store(generation, memory_order_release);
+        if (e->brut->getPoignee() == poignee) {
+            e->brut->setPoignee(PoigneeProduit());
+        }
+        e->brut = nullptr;
+        ancien.swap(e->produit);
+        libres.push_back(poignee.indice);
+        nbr_vivants--;
+    }
+}
+
+/**
+ * @brief Retourne le produit d'une poignée, sans verrou ni compteur de références.
+ * @param poignee La poignée.
+ * @return Le produit, ou nullptr si la poignée est nulle ou périmée.
+ */
+Produit* TableProduits::obtenir(PoigneeProduit poignee) const {
+    if (poignee.estNulle() || poignee.indice >= nbr_emplacements.load(memory_order_acquire)) {
+        return nullptr;
+    }
+    const Emplacement* e = emplacement(poignee.indice);
+    return e->generation.load(memory_order_acquire) == poignee.generation ? e->brut : nullptr;
+}
+
+/**
+ * @brief Retourne un shared_ptr sur le produit d'une poignée, pour le garder au-delà de sa libération.
+ * @param poignee La poignée.
+ * @return Le produit partagé, ou nullptr si la poignée est nulle ou périmée.
+ */
+shared_ptr<Produit> TableProduits::partager(PoigneeProduit poignee) const {
+    lock_guard<mutex> lock(mtx);
+    if (obtenir(poignee) == nullptr) {
+        return nullptr;
+    }
+    return emplacement(poignee.indice)->produit;
+}
+
+/**
+ * @brief Retourne le nombre de produits enregistrés et pas encore libérés.
+ * @return Le nombre de produits vivants.
+ */
+size_t TableProduits::getTaille() const {
+    lock_guard<mutex> lock(mtx);
+    return nbr_vivants;
+}
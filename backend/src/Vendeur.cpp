@@ -11,6 +11,8 @@
 #include "Produit.h"
 #include "Message.h"
 #include "Threads_var.h"
+#include "Catalogue.h"
+#include "TableProduits.h"
 #include <thread>
 #include <vector>
 #include <algorithm>
@@ -27,8 +29,8 @@ using namespace std;
  * @param nombre_acheteur Le nombre d'acheteurs avec lesquels le vendeur peut entrer en négociation.
  */
 Vendeur::Vendeur(int id, int nombre_acheteur)
+    : aleatoire(GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_VENDEUR, id)), echelle_prix(make_shared<EchellePrix>())
 {
-    produits={};
     vendeur_id=id;
     style_negociacion=0;
     boite_au_lettres.resize(nombre_acheteur);
@@ -47,7 +49,7 @@ Vendeur::Vendeur(int id, int nombre_acheteur)
 Vendeur::~Vendeur()
 {
 
-        produits.clear();
+        vendus.clear();
 
 }
 
@@ -74,17 +76,38 @@ Vendeur::~Vendeur()
 //ajouter un produit au vecteur
 void Vendeur::addVoiture(int id,string description,float prix,string categorie,string image,string br, string mod,int year, string bdv, int km, string essen,float mpg, float te){
 
-    int x=produits.size();
+    int x=inventaire.getTaille();
     if (x>0){
      x--;
-    x=produits[x]->getId();
+    x=inventaire.getProduits()[x]->getId();
     x++;
     }
 
-    shared_ptr<Produit> p=make_shared<Voiture>( id,description, prix, categorie, image, br, mod, year,  bdv, km,  essen, mpg, te);
-    produits.push_back(p);
+    shared_ptr<Produit> p=allocate_shared<Voiture>(AllocateurArena<Voiture>(arena_produits), id,description, prix, categorie, image, br, mod, year,  bdv, km,  essen, mpg, te);
+    p->setEchelle(echelle_prix);
+    TableProduits::getInstance().enregistrer(p);
+    inventaire.ajouter(p, -1);
+    index.ajouter(p, -1);
 
 }
+
+/**
+ * @brief Ajouter au vendeur la voiture d'une ligne du catalogue.
+ *
+ * Le vendeur garde l'indice de la ligne, ce qui permet ensuite de comparer ses produits
+ * directement dans les colonnes du catalogue.
+ *
+ * @param id L'identifiant du produit.
+ * @param ligne L'indice de la ligne dans le catalogue en colonnes.
+ */
+void Vendeur::addVoitureCatalogue(int id, uint32_t ligne){
+    const CatalogueColonnes& colonnes=Catalogue::getInstance().getColonnes();
+    shared_ptr<Produit> p=allocate_shared<Voiture>(AllocateurArena<Voiture>(arena_produits), colonnes.creerVoiture(ligne, id));
+    p->setEchelle(echelle_prix);
+    TableProduits::getInstance().enregistrer(p);
+    inventaire.ajouter(p, static_cast<int>(ligne));
+    index.ajouter(p, static_cast<int>(ligne));
+}
 /**
  * @file Vendeur.cpp
  * @brief Implémentation de la classe Vendeur qui gère les opérations liées à un vendeur dans un système de négociation.
@@ -96,43 +119,90 @@ void Vendeur::addVoiture(int id,string description,float prix,string categorie,s
 
 
 /**
- * @brief Supprimer un produit du vecteur des produits.
+ * @brief Supprimer un produit de l'inventaire.
  *
- * Cette fonction permet de supprimer un produit en fonction de son identifiant.
+ * Cette fonction permet de supprimer un produit en fonction de son identifiant, retrouvé par l'index : l'inventaire
+ * et les index le retirent en temps constant (hors recalcul paresseux de l'index multi-attributs).
+ * Sa poignée est libérée : les messages qui le désignent encore ne le retrouvent plus.
  *
  * @param id L'identifiant du produit à supprimer.
  */
 
 //supprimer un produit au vecteur
 void Vendeur::deleteProduits(int id){
-    for (int i = 0; i < produits.size(); i++)
+    shared_ptr<Produit> p=index.chercherId(id);
+    if (p==nullptr)
     {
-        if (produits[i]->getId()==id)
-        {
-            for (int x = i; x < produits.size()-1; x++)
-            {
-                produits[x]=produits[x+1];
-
-            }
-             produits.pop_back();
-              break;
-        }
+        return;
+    }
+    index.retirer(p.get());
+    inventaire.retirer(p.get());
+    TableProduits::getInstance().liberer(p->getPoignee());
+}
 
+/**
+ * @brief Retirer un produit vendu de l'inventaire et des index.
+ *
+ * Contrairement à deleteProduits, la poignée du produit est gardée jusqu'à libererProduits : les messages de la
+ * négociation qui l'a vendu le désignent encore.
+ *
+ * @param p Le produit vendu.
+ * @return True si le produit appartenait à ce vendeur.
+ */
+bool Vendeur::vendre(const Produit* p){
+    InventaireVendeur::Cle cle=inventaire.getCle(p);
+    shared_ptr<Produit> vendu=inventaire.obtenir(cle);
+    if (vendu==nullptr)
+    {
+        return false;
     }
+    index.retirer(vendu.get());
+    inventaire.retirer(cle);
+    vendus.push_back(vendu->getPoignee());
+    return true;
+}
 
+/**
+ * @brief Libérer les poignées de tous les produits du vendeur.
+ *
+ * Les copies d'un vendeur partagent ses produits, le destructeur ne peut donc pas le faire : à appeler une
+ * fois, hors négociation, quand le vendeur est abandonné. Les voitures achetées restent au garage, qui a
+ * enregistré sa propre poignée.
+ */
+void Vendeur::libererProduits(){
+    for (const shared_ptr<Produit>& p : inventaire.getProduits())
+    {
+        TableProduits::getInstance().liberer(p->getPoignee());
+    }
+    for (PoigneeProduit v : vendus)
+    {
+        TableProduits::getInstance().liberer(v);
+    }
+    vendus.clear();
 }
 
 /**
  * @brief Augmenter le prix de tous les produits du vendeur.
  *
- * Cette fonction permet d'augmenter le prix de tous les produits d'un pourcentage donné.
+ * Cette fonction permet d'augmenter le prix de tous les produits d'un pourcentage donné. Seul le facteur de
+ * l'échelle du vendeur change, chaque produit l'applique à la lecture de son prix : le coût ne dépend plus du
+ * nombre de produits. L'ordre des prix est le même pour tous les produits du vendeur, l'index reste trié.
  *
  * @param pourcentage Le pourcentage d'augmentation du prix.
  */
 void Vendeur::augmenterTousPrix(int pourcentage){
-    for(int i=0; produits.size()>i; i++){
-        double nouveauPrix=produits[i]->getPrix()*((pourcentage/100)+1);
-        produits[i]->setPrix(nouveauPrix);
+    echelle_prix->multiplier(1.0 + pourcentage / 100.0);
+}
+
+/**
+ * @brief Reporter les augmentations en attente dans le prix de chaque produit.
+ *
+ * Un seul passage sur l'inventaire, à la fin d'une négociation : les prix lus ensuite n'ont plus de rapport
+ * de facteurs à calculer.
+ */
+void Vendeur::appliquerPrix(){
+    for (const shared_ptr<Produit>& p : inventaire.getProduits()) {
+        p->setPrix(p->getPrix());
     }
 }
 
@@ -197,6 +267,15 @@ void Vendeur::setBalSize(int size){
      tour_karma=i;
  }
 
+/**
+ * @brief Définir l'arène des voitures du vendeur, partagée par les vendeurs d'une même initialisation.
+ *
+ * @param arena L'arène de la session, nullptr pour allouer les voitures sur le tas.
+ */
+void Vendeur::setArenaProduits(shared_ptr<ArenaSession> arena){
+    arena_produits=arena;
+}
+
  //getteurs
  int Vendeur::get_tKarma(){
      return tour_karma;
@@ -211,8 +290,12 @@ void Vendeur::setBalSize(int size){
  * @param id L'identifiant de la boîte aux lettres à récupérer.
  * @return La boîte aux lettres de l'acheteur correspondant.
  */
-vector<shared_ptr<Produit>> Vendeur::getProduits(){
-    return produits;
+const vector<shared_ptr<Produit>>& Vendeur::getProduits() const{
+    return inventaire.getProduits();
+}
+
+const vector<int>& Vendeur::getLignesCatalogue() const{
+    return inventaire.getLignes();
 }
 
 int Vendeur::getVendeur_id()const{
@@ -245,238 +328,357 @@ shared_ptr<BoiteAuLettres> Vendeur::getBoiteAuLettres(int id) const {
  */
 
 void Vendeur::afficherProduits()const{
-    for (int i = 0; i < produits.size(); i++)
+    for (const shared_ptr<Produit>& p : inventaire.getProduits())
     {
-        produits[i]->afficherTout();
+        p->afficherTout();
     }
 
 }
 
-shared_ptr<Message> Vendeur::creerMessage( string obj, float offr, string mess,shared_ptr<Produit> prod,int id_achet)
+Message Vendeur::creerMessage(Verbe obj, float offr, PoigneeProduit prod,int id_achet)
 {
-    string str="vender"+to_string(vendeur_id);
-    shared_ptr<Message> m=make_shared<Message>(vendeur_id, id_achet , obj, offr, mess,prod);
-    return m;
+    return Message(vendeur_id, id_achet, obj, offr, prod);
+}
+
+/**
+ * @brief Compare un produit hors catalogue à la voiture recherchée.
+ *
+ * Les chaînes vides et les valeurs numériques nulles de la voiture recherchée signifient "peu importe".
+ * Les chaînes sont comparées par leurs identifiants internés.
+ *
+ * @param critere La voiture recherchée.
+ * @param v La voiture du vendeur.
+ * @return True si la voiture du vendeur correspond.
+ */
+bool Vendeur::correspondVoiture(const Voiture& critere, const Voiture& v){
+    return (critere.getIdCategorie()==v.getIdCategorie()||critere.getIdCategorie()==TableChaines::VIDE)
+        && (critere.getIdBrand()==v.getIdBrand()||critere.getIdBrand()==TableChaines::VIDE)
+        && (critere.getIdModel()==v.getIdModel()||critere.getIdModel()==TableChaines::VIDE)
+        && critere.getYear()<=v.getYear()
+        && (critere.getIdBoiteDeVitesse()==v.getIdBoiteDeVitesse()||critere.getIdBoiteDeVitesse()==TableChaines::VIDE)
+        && (critere.getKilometres()>=v.getKilometres()||critere.getKilometres()==0)
+        && (critere.getIdEssence()==v.getIdEssence()||critere.getIdEssence()==TableChaines::VIDE)
+        && (critere.getMPG()<=v.getMPG()||critere.getMPG()==0)
+        && (critere.getTailleEngin()<=v.getTailleEngin()||critere.getTailleEngin()==0);
 }
 
-shared_ptr<Produit> Vendeur::chercherProduit(shared_ptr<Produit> prod){
-    shared_ptr<Voiture> p1=dynamic_pointer_cast<Voiture>(prod);
-    shared_ptr<Voiture> p2=nullptr;
+/**
+ * @brief Chercher le produit le moins cher correspondant à une recherche.
+ *
+ * Un produit ayant le même identifiant est retourné directement. Si la marque et le modèle sont précisés, seul
+ * le seau correspondant de l'index est parcouru, par prix croissant, jusqu'au premier produit qui convient.
+ * Sinon l'index multi-attributs ne parcourt que les produits qui respectent la borne la plus sélective.
+ *
+ * @param prod La voiture recherchée.
+ * @return Le produit le moins cher qui convient, ou nullptr.
+ */
+shared_ptr<Produit> Vendeur::chercherProduit(const Produit* prod){
+    const Voiture* p1=commeVoiture(prod);
+    const CatalogueColonnes& colonnes=Catalogue::getInstance().getColonnes();
+    CritereColonnes critere=colonnes.traduireCritere(*p1);
     produits_possibles.clear();
-    produits_possibles.shrink_to_fit();
-    for (int i = 0; i < produits.size(); i++)
-    {
-        if(prod->getId()==produits[i]->getId()){
-            produits_possibles.push_back(produits[i]);
-            return produits[i];
-        }
-        
-        p2=dynamic_pointer_cast<Voiture>(produits[i]);
-
-        if(p1->getCategorie()==p2->getCategorie()||p1->getCategorie()==""){
-            if(p1->getBrand()==p2->getBrand()||p1->getBrand()==""){
-                if(p1->getModel()==p2->getModel()||p1->getModel()==""){
-                    if(p1->getYear()<=p2->getYear()){
-                        if(p1->getBoiteDeVitesse()==p2->getBoiteDeVitesse()||p1->getBoiteDeVitesse()==""){
-                            if(p1->getKilometres()>=p2->getKilometres()||p1->getKilometres()==0){
-                                if(p1->getEssence()==p2->getEssence()||p1->getEssence()==""){
-                                    if(p1->getMPG()<=p2->getMPG()||p1->getMPG()==0){
-                                        if(p1->getTailleEngin()<=p2->getTailleEngin()||p1->getTailleEngin()==0){
-                                            produits_possibles.push_back(produits[i]);
-                                        }
-                                    }
-                                }
-                            }   
-                        }
-                    }
+
+    shared_ptr<Produit> meme_id=index.chercherId(prod->getId());
+    if(meme_id!=nullptr){
+        produits_possibles.push_back(meme_id);
+        return meme_id;
+    }
+
+    if(p1->getIdBrand()!=TableChaines::VIDE && p1->getIdModel()!=TableChaines::VIDE){
+        //Premier produit qui convient dans le seau, trie par prix
+        const vector<IndexProduits::Entree>* seau=index.seau(p1->getIdBrand(), p1->getIdModel());
+        if(seau!=nullptr){
+            for(const IndexProduits::Entree& e : *seau){
+                bool convient=e.ligne>=0 ? colonnes.correspond(e.ligne, critere)
+                                         : correspondVoiture(*p1, *commeVoiture(e.produit.get()));
+                if(convient){
+                    produits_possibles.push_back(e.produit);
+                    break;
                 }
             }
         }
+    }else{
+        //Recherche par intervalles (annee, kilometres, mpg, moteur), avec ou sans marque
+        shared_ptr<Produit> moins_cher=index.chercherAttributs(*p1);
+        if(moins_cher!=nullptr){
+            produits_possibles.push_back(moins_cher);
+        }
     }
 
     if(produits_possibles.empty()){
         return nullptr;
-    }else{
-        std::sort(produits_possibles.begin(), produits_possibles.end(),
-                  [](const std::shared_ptr<Produit>& a, const std::shared_ptr<Produit>& b) {
-                      auto voitureA = std::dynamic_pointer_cast<Voiture>(a);
-                      auto voitureB = std::dynamic_pointer_cast<Voiture>(b);
+    }
+    return *std::min_element(produits_possibles.begin(), produits_possibles.end(),
+                             [](const std::shared_ptr<Produit>& a, const std::shared_ptr<Produit>& b) {
+                                 return a->getPrix() < b->getPrix();
+                             });
+}
 
-                      if (voitureA && voitureB) {
-                          return voitureA->getPrix() < voitureB->getPrix();
-                      }
+/**
+ * @brief Chercher le produit le moins cher pour chacune d'un lot de recherches.
+ *
+ * Donne, pour chaque recherche, un produit au même prix que chercherProduit. Les recherches sans produit de même
+ * identifiant sont évaluées ensemble sur les colonnes de l'inventaire (FiltreLot, AVX2 si disponible), ce qui
+ * évite de reprendre la recherche depuis le début pour chaque acheteur quand beaucoup interrogent ce vendeur.
+ *
+ * @param recherches Les voitures recherchées.
+ * @return Le produit le moins cher de chaque recherche, nullptr si aucun ne convient.
+ */
+vector<shared_ptr<Produit>> Vendeur::chercherProduits(const vector<const Produit*>& recherches){
+    vector<shared_ptr<Produit>> resultats(recherches.size());
+    vector<const Voiture*> criteres;
+    vector<size_t> positions;
+    for(size_t i=0;i<recherches.size();i++){
+        resultats[i]=index.chercherId(recherches[i]->getId());
+        if(resultats[i]==nullptr){
+            criteres.push_back(commeVoiture(recherches[i]));
+            positions.push_back(i);
+        }
+    }
 
-                      return false;
-                  });
+    vector<shared_ptr<Produit>> trouves;
+    index.chercherLot(criteres, trouves);
+    for(size_t j=0;j<positions.size();j++){
+        resultats[positions[j]]=trouves[j];
+    }
+    return resultats;
+}
 
-        return produits_possibles[0];
+/**
+ * @brief Évalue ensemble toutes les recherches qui attendent une réponse de ce vendeur.
+ *
+ * Quand les acheteurs cherchent en même temps, plusieurs recherches arrivent avant que le vendeur ne réponde à
+ * la première. Elles sont passées en un seul lot à chercherProduits, et le résultat de chacune est gardé dans sa
+ * discussion jusqu'à ce que le vendeur y réponde. Une recherche seule garde le chemin de chercherProduit.
+ *
+ * @param conversations L'état de la discussion avec chaque acheteur.
+ * @param source La boîte dont la recherche vient d'être lue.
+ */
+void Vendeur::chercherEnLot(vector<Conversation>& conversations, int source){
+    vector<const Produit*> recherches;
+    vector<size_t> boites;
+    vector<int> messages;
+    for (size_t i = 0; i < conversations.size(); i++)
+    {
+        int message=boite_au_lettres[i]->getNbrMessages(BoiteAuLettres::Emetteur::ACHETEUR);
+        if(static_cast<int>(i)==source){
+            message=conversations[i].lus;
+        }else if(conversations[i].active || message<=conversations[i].lus){
+            continue;
+        }
+        Message recherche=boite_au_lettres[i]->dernierMessage();
+        if(recherche.getObjet()==Verbe::SEARCH && commeVoiture(recherche.getProduit())!=nullptr){
+            recherches.push_back(recherche.getProduit());
+            boites.push_back(i);
+            messages.push_back(message);
+        }
+    }
+    if(recherches.size()<2){
+        return;
+    }
+
+    vector<shared_ptr<Produit>> trouves=chercherProduits(recherches);
+    for (size_t j = 0; j < boites.size(); j++)
+    {
+        conversations[boites[j]].recherche_en_lot=messages[j];
+        conversations[boites[j]].trouve=trouves[j];
     }
 }
 
 
-void Vendeur::negocier(int thread_id, int num_threads){
+/**
+ * @brief Cherche une boîte où un acheteur attend une réponse.
+ *
+ * Un réveil ne dit pas quel acheteur a écrit : plusieurs recherches peuvent arriver en même temps, et le
+ * vendeur peut négocier avec plusieurs acheteurs. Les négociations en cours passent avant les nouvelles recherches.
+ *
+ * @param conversations L'état de la discussion avec chaque acheteur.
+ * @param relance Reçoit true si l'acheteur a réveillé le vendeur sans laisser de message.
+ * @return L'indice de la boîte, -1 si aucun acheteur n'attend.
+ */
+int Vendeur::boiteEnAttente(const vector<Conversation>& conversations, bool& relance) const{
+    for (size_t i = 0; i < conversations.size(); i++)
+    {
+        if(!conversations[i].active){
+            continue;
+        }
+        if(boite_au_lettres[i]->getNbrMessages(BoiteAuLettres::Emetteur::ACHETEUR)>conversations[i].lus){
+            relance=false;
+            return static_cast<int>(i);
+        }
+        if(boite_au_lettres[i]->getNbrRelances()>conversations[i].relances_lues){
+            relance=true;
+            return static_cast<int>(i);
+        }
+    }
+    for (size_t i = 0; i < conversations.size(); i++)
+    {
+        if(!conversations[i].active && boite_au_lettres[i]->getNbrMessages(BoiteAuLettres::Emetteur::ACHETEUR)>conversations[i].lus){
+            relance=false;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Répond aux messages des acheteurs jusqu'à la fin de la session.
+ *
+ * C'est une coroutine : entre deux messages, le vendeur est suspendu sur son événement (co_await) et ne
+ * retient aucun thread.
+ *
+ * Le vendeur garde l'état de chaque discussion dans une table, une entrée par acheteur, et peut mener jusqu'à
+ * Protocol::getCapaciteVendeur négociations en même temps. Au-delà, une nouvelle recherche reçoit un break-down,
+ * comme une recherche de voiture qu'il n'a pas ; de même si la voiture trouvée est déjà en négociation avec un
+ * autre acheteur, pour qu'elle ne soit pas vendue deux fois.
+ *
+ * @param thread_id L'identifiant du vendeur dans la négociation.
+ * @return La négociation, suspendue jusqu'à Negociation::demarrer.
+ */
+Negociation Vendeur::negocier(int thread_id){
+    Evenement& reveil = *evenements_Vend[thread_id];
 
     bool enNegociation=true;
 
-    shared_ptr<Message> dernierMessage=nullptr;
-    shared_ptr<Message> m=nullptr;
-
-    int id_acheteur_en_negociation=-1;
-
-    shared_ptr<Produit> prod;
-    float acheteur_offre=0.0f;
-    float acheteur_offre_avant=-1;
-    float vendeur_offre=0.0f;
-    float prix_minimale=0.0f;
-    int id_next_Vendeur=-1;
-    bool chain_vendeur=false;
-    int nombre_de_tours_max=0;
-    float pas=0.0f;
-    num_threads--; 
+    Message dernierMessage;
+    Message m;
+
+    vector<Conversation> conversations(boite_au_lettres.size());
+    int nbr_actives=0;
+    int capacite=boite_au_lettres.empty() ? 1 : boite_au_lettres[0]->getProtocol()->getCapaciteVendeur();
+
+    //Fin d'une discussion, les compteurs de lecture de la boite sont gardes
+    auto oublierNegociation = [&](Conversation& c) {
+        Conversation vide;
+        vide.lus=c.lus;
+        vide.relances_lues=c.relances_lues;
+        c=vide;
+        nbr_actives--;
+    };
     
 
     while (enNegociation)
     {
         
-        {
-            cout<<"Vendeur "<<thread_id<<"stop (vendeur.cpp 151)"<<endl;
-            std::unique_lock<std::mutex> lock(mtx);
-            child_Vend_cvs[thread_id]->wait(lock, [thread_id] { return child_ready_flags_Vend[thread_id]->load(); });
-            cout<<"Vendeur "<<thread_id<<"continue (vendeur.cpp 154)"<<endl;
-        }
-
-
+        co_await reveil.attendre();
 
         //logique
         if(termination_flag->load()){
-            return;
+            co_return;
         }
         //Extraction du dernier message
-        if(id_acheteur_en_negociation==-1){
-            for (int i = 0; i < boite_au_lettres.size(); i++)
-            {
-                if(!boite_au_lettres[i]->estVide()&& boite_au_lettres[i]->dernierMessage()->getObjet()=="search"){
-                    dernierMessage=boite_au_lettres[i]->dernierMessage();
-                    acheteur_offre=dernierMessage->getOffre();
-                    id_acheteur_en_negociation=i;
-                    nombre_de_tours_max=boite_au_lettres[i]->getProtocol()->getNbrTours();
-                    //cout<<"dernier message extrait"<<endl;
-
-                }
-            }
-
+        bool relance=false;
+        int source=boiteEnAttente(conversations, relance);
+        if(source<0){
+            reveil.consommer();
+            continue;
+        }
+        Conversation& c=conversations[source];
+        if(relance){
+            c.relances_lues++;
         }else{
-            dernierMessage=boite_au_lettres[id_acheteur_en_negociation]->dernierMessage();
-            acheteur_offre=dernierMessage->getOffre();
+            c.lus++;
         }
+        dernierMessage=boite_au_lettres[source]->dernierMessage();
+        if(!c.active && dernierMessage.getObjet()!=Verbe::SEARCH){
+            //Fin d'une recherche refusee, rien a repondre
+            reveil.consommer();
+            continue;
+        }
+        if(!c.active && nbr_actives>=capacite){
+            //Capacite atteinte : la recherche est refusee
+            boite_au_lettres[source]->laisserMessage(creerMessage(Verbe::BREAK_DOWN,0,dernierMessage.getPoigneeProduit(),source), BoiteAuLettres::Emetteur::VENDEUR);
+            reveil.consommer();
+            collectes_Achet[source]->deposer(thread_id, false);
+            continue;
+        }
+        if(!c.active){
+            c.active=true;
+            nbr_actives++;
+            c.nombre_de_tours_max=boite_au_lettres[source]->getProtocol()->getNbrTours();
+        }
+        c.acheteur_offre=dernierMessage.getOffre();
 
         //Logique dependante du objet du message
-        if(dernierMessage->getObjet()=="search"){
-           // cout<<"Vendeur "<<thread_id<<" search"<<endl;
+        if(dernierMessage.getObjet()==Verbe::SEARCH){
 
-            m=neg_search(dernierMessage,enNegociation,prix_minimale, prod);
-            if(thread_id<num_threads){
+            if(c.recherche_en_lot!=c.lus){
+                chercherEnLot(conversations, source);
+            }
+            shared_ptr<Produit> trouve;
+            if(c.recherche_en_lot==c.lus && (c.trouve==nullptr || inventaire.getCle(c.trouve.get()).generation!=0)){
+                trouve=c.trouve;
+            }else{
+                //Pas de lot, ou la voiture du lot a ete vendue depuis
+                trouve=chercherProduit(dernierMessage.getProduit());
+            }
+            c.recherche_en_lot=-1;
+            c.trouve=nullptr;
 
-                    id_next_Vendeur=thread_id;
-                    id_next_Vendeur++;
-                    chain_vendeur=true;
+            m=neg_search(dernierMessage,trouve,enNegociation,c.prix_minimale, c.prod);
+            for (size_t i = 0; i < conversations.size() && m.getObjet()==Verbe::OFFER; i++)
+            {
+                if(static_cast<int>(i)!=source && conversations[i].active && conversations[i].prod==c.prod){
+                    //La voiture est deja en negociation avec un autre acheteur
+                    c.prod=dernierMessage.getPoigneeProduit();
+                    m=creerMessage(Verbe::BREAK_DOWN,0,c.prod,dernierMessage.getIdEmmeteur());
+                }
             }
 
-        }else if(dernierMessage->getObjet()=="offer"&&acheteur_offre_avant!=acheteur_offre){
-             //cout<<"Vendeur "<<thread_id<<" offer"<<endl;
-            m=neg_offre(dernierMessage,prix_minimale,vendeur_offre,acheteur_offre,acheteur_offre_avant,pas,enNegociation,nombre_de_tours_max);
-        }else if(dernierMessage->getObjet()=="offer"&&acheteur_offre_avant==acheteur_offre){
-             cout<<"Vendeur "<<thread_id<<" breakdown"<<endl;
-            m=neg_breakdown(dernierMessage, enNegociation, id_acheteur_en_negociation);
+        }else if(dernierMessage.getObjet()==Verbe::OFFER&&c.acheteur_offre_avant!=c.acheteur_offre){
+            m=neg_offre(dernierMessage,c.prix_minimale,c.vendeur_offre,c.acheteur_offre,c.acheteur_offre_avant,c.pas,enNegociation,c.nombre_de_tours_max);
+        }else if(dernierMessage.getObjet()==Verbe::OFFER&&c.acheteur_offre_avant==c.acheteur_offre){
+            m=neg_breakdown(dernierMessage, enNegociation, source);
         }
 
-        if(dernierMessage->getObjet()=="break-down"){
-             //cout<<"Vendeur "<<thread_id<<" fin breakdown"<<endl;
-            if((boite_au_lettres[id_acheteur_en_negociation]->getSize()/2)>=tour_karma){
-               // cout<<"Karma !!! Les prix augmentent"<<endl;
-                augmenterTousPrix(boite_au_lettres[id_acheteur_en_negociation]->getProtocol()->getPenalite());
+        if(dernierMessage.getObjet()==Verbe::BREAK_DOWN){
+            if((boite_au_lettres[source]->getSize()/2)>=tour_karma){
+                augmenterTousPrix(boite_au_lettres[source]->getProtocol()->getPenalite());
             }
-            int id_temp=id_acheteur_en_negociation;
-            dernierMessage=nullptr;
-            m=nullptr;
-            id_acheteur_en_negociation=-1;
-            prod=nullptr;
-            acheteur_offre=0.0f;
-            acheteur_offre_avant=-1;
-            vendeur_offre=0.0f;
-            prix_minimale=0.0f;
-            pas=0.0f;
+            oublierNegociation(c);
             {
-                std::lock_guard<std::mutex> lock(mtx);
-                *child_ready_flags_Vend[thread_id] = false;
-                if(boite_au_lettres[id_temp]->getSize()>3){
-                    *child_ready_flags_Achet[id_temp] = true;
-                    child_Achet_cvs[id_temp]->notify_one();
-                    cout<<"Vendeur"<<thread_id<<"-> Acheteur "<<id_temp<<"notifie (vendeur.cpp 213)"<<endl;
+                reveil.consommer();
+                if(boite_au_lettres[source]->getSize()>3){
+                    evenements_Achet[source]->signaler();
                 }
             }
-        }else if(dernierMessage->getObjet()=="accept"){
-             //cout<<"Vendeur "<<thread_id<<" fin accept"<<endl;
-            int id_temp=id_acheteur_en_negociation;
-            dernierMessage=nullptr;
-            m=nullptr;
-            id_acheteur_en_negociation=-1;
-            prod=nullptr;
-            acheteur_offre=0.0f;
-            acheteur_offre_avant=-1;
-            vendeur_offre=0.0f;
-            prix_minimale=0.0f;
-            pas=0.0f;
+        }else if(dernierMessage.getObjet()==Verbe::ACCEPT){
+            //Vendue des l'accord : la voiture n'est plus proposee aux acheteurs suivants ou simultanes
+            vendre(TableProduits::getInstance().obtenir(c.prod));
+            oublierNegociation(c);
             {
-                std::lock_guard<std::mutex> lock(mtx);
-                *child_ready_flags_Vend[thread_id] = false;
-                *child_ready_flags_Achet[id_temp] = true;
-                child_Achet_cvs[id_temp]->notify_one();
-                cout<<"Vendeur"<<thread_id<<"-> Acheteur "<<id_temp<<"notifie (vendeur.cpp 213)"<<endl;
+                reveil.consommer();
+                evenements_Achet[source]->signaler();
             }
 
 
         }else{
-        boite_au_lettres[id_acheteur_en_negociation]->laisserMessage(m);
-        vendeur_offre=m->getOffre();
-        //cout<<"message laissee"<<endl;
+        boite_au_lettres[source]->laisserMessage(m, BoiteAuLettres::Emetteur::VENDEUR);
+        c.vendeur_offre=m.getOffre();
 
         {
-            std::lock_guard<std::mutex> lock(mtx);
-            *child_ready_flags_Vend[thread_id] = false;  
-            if(chain_vendeur){
-                *child_ready_flags_Vend[id_next_Vendeur] = true; 
+            reveil.consommer();  
+            if(dernierMessage.getObjet()==Verbe::SEARCH){
+                //La reponse a une recherche va dans la collecte de l'acheteur, qui ne la lira plus si elle est fermee
+                if(!collectes_Achet[source]->deposer(thread_id, m.getObjet()==Verbe::OFFER)){
+                    oublierNegociation(c);
+                }
             }else{
-                
-                *child_ready_flags_Achet[id_acheteur_en_negociation] = true;  
+                evenements_Achet[source]->signaler();  
             }
-
-
-
-         if(chain_vendeur){
-            child_Vend_cvs[id_next_Vendeur]->notify_one();
-            cout<<"Vendeur"<<thread_id<<"-> Vendeur "<<id_next_Vendeur<<"notifie (vendeur.cpp 210)"<<endl;
-         }else{
-            child_Achet_cvs[id_acheteur_en_negociation]->notify_one();
-            cout<<"Vendeur"<<thread_id<<"-> Acheteur "<<id_acheteur_en_negociation<<"notifie (vendeur.cpp 213)"<<endl;
-        }
-        chain_vendeur=false;
         }
 
         }
 
     }
     
-    cout<<"Vendeur"<<thread_id<<"termine";
 }
 
-shared_ptr<Message> Vendeur::neg_search(shared_ptr<Message> dernierMessage, bool &enNegociation, float &prix_minimale,shared_ptr<Produit> &prod){
-        std::lock_guard<std::mutex> lock(mtx); // Automatisch freigeben
-
-    prod=chercherProduit(dernierMessage->getProduit());
+Message Vendeur::neg_search(const Message& dernierMessage, const shared_ptr<Produit>& trouve, bool &enNegociation, float &prix_minimale,PoigneeProduit &prod){
 
-            shared_ptr<Message> m=nullptr;
-            if(prod!=nullptr){
+            Message m;
+            if(trouve!=nullptr){
+                prod=trouve->getPoignee();
 
                 //calculer prix de depart
                 int min,max; //min & max du pourcentage du prix du depart  
@@ -505,51 +707,48 @@ shared_ptr<Message> Vendeur::neg_search(shared_ptr<Message> dernierMessage, bool
                     max= 1400;
                     break;
                 }
-                float comm= static_cast<float>((rand() % (max - min + 1)) + min)/1000 ;
-                prix_minimale=prod->getPrix();
+                float comm= static_cast<float>(aleatoire.entre(min, max))/1000 ;
+                prix_minimale=trouve->getPrix();
                 setPrix(prix_minimale);
                 int vendeur_offre=prix_minimale*comm;
-                m=creerMessage("offer",vendeur_offre,"",prod,dernierMessage->getIdEmmeteur());
+                m=creerMessage(Verbe::OFFER,vendeur_offre,prod,dernierMessage.getIdEmmeteur());
 
 
             }else{
-                prod=dernierMessage->getProduit();
+                prod=dernierMessage.getPoigneeProduit();
 
-                m=creerMessage("break-down",0,"",prod,dernierMessage->getIdEmmeteur());
+                m=creerMessage(Verbe::BREAK_DOWN,0,prod,dernierMessage.getIdEmmeteur());
                 //enNegociation=false;
             }
 
             return m;
 }
 
-shared_ptr<Message> Vendeur::neg_accept(shared_ptr<Message> dernierMessage, bool &enNegociation){
-        std::lock_guard<std::mutex> lock(mtx); //
+Message Vendeur::neg_accept(const Message& dernierMessage, bool &enNegociation){
     //enNegociation=false;
-    return creerMessage("accept",dernierMessage->getOffre(),"",dernierMessage->getProduit(),dernierMessage->getIdEmmeteur());
+    return creerMessage(Verbe::ACCEPT,dernierMessage.getOffre(),dernierMessage.getPoigneeProduit(),dernierMessage.getIdEmmeteur());
 }
 
-shared_ptr<Message> Vendeur::neg_breakdown(shared_ptr<Message> dernierMessage, bool &enNegociation, int &id_acheteur_en_Negociation){
+Message Vendeur::neg_breakdown(const Message& dernierMessage, bool &enNegociation, int &id_acheteur_en_Negociation){
 
-        std::lock_guard<std::mutex> lock(mtx); //
 
 
-    return creerMessage("break-down",0,"",dernierMessage->getProduit(),dernierMessage->getIdEmmeteur());
+    return creerMessage(Verbe::BREAK_DOWN,0,dernierMessage.getPoigneeProduit(),dernierMessage.getIdEmmeteur());
 }
 
-shared_ptr<Message> Vendeur::neg_offre(shared_ptr<Message> dernierMessage,float &prix_cible, float &vendeur_offre,float &acheteur_offre,float &acheteur_offre_avant, float &pasapas, bool &enNegociation, int &nombre_de_tours){
-    std::lock_guard<std::mutex> lock(mtx); // Automatisch freigeben
+Message Vendeur::neg_offre(const Message& dernierMessage,float &prix_cible, float &vendeur_offre,float &acheteur_offre,float &acheteur_offre_avant, float &pasapas, bool &enNegociation, int &nombre_de_tours){
 float offre_nouvelle=0.0f;
-string objet="";
+Verbe objet=Verbe::AUCUN;
 int min=0,max=0;
 float comm=0.0f;
 
-        if(dernierMessage->getOffre()>=prix_cible){ //"accept"
-                objet="accept";
-                offre_nouvelle=dernierMessage->getOffre();
+        if(dernierMessage.getOffre()>=prix_cible){ //"accept"
+                objet=Verbe::ACCEPT;
+                offre_nouvelle=dernierMessage.getOffre();
                 //enNegociation=false;
         }else{
 
-            objet="offer";
+            objet=Verbe::OFFER;
 
             switch (style_negociacion)
             {
@@ -574,7 +773,7 @@ float comm=0.0f;
                 
                     min=90;
                     max=95;
-                    comm= static_cast<float>((rand() % (max - min + 1)) + min)/100 ;
+                    comm= static_cast<float>(aleatoire.entre(min, max))/100 ;
                     offre_nouvelle=vendeur_offre*comm;
                 
                 break;
@@ -610,7 +809,7 @@ float comm=0.0f;
     
     acheteur_offre_avant=acheteur_offre;
     vendeur_offre=offre_nouvelle;
-    return creerMessage(objet,offre_nouvelle,"",dernierMessage->getProduit(),dernierMessage->getIdEmmeteur());
+    return creerMessage(objet,offre_nouvelle,dernierMessage.getPoigneeProduit(),dernierMessage.getIdEmmeteur());
 
 }
 
@@ -31,8 +31,8 @@ Voiture::~Voiture() {}
  *
  * \return La marque de la voiture.
  */
-string Voiture::getBrand() const {
-    return brand;
+const string& Voiture::getBrand() const {
+    return TableChaines::getInstance().getChaine(brand);
 }
 
 /**
@@ -40,8 +40,8 @@ string Voiture::getBrand() const {
  *
  * \return Le modèle de la voiture.
  */
-string Voiture::getModel() const {
-    return model;
+const string& Voiture::getModel() const {
+    return TableChaines::getInstance().getChaine(model);
 }
 
 /**
@@ -58,8 +58,8 @@ int Voiture::getYear() const {
  *
  * \return Le type de boîte de vitesses.
  */
-string Voiture::getBoiteDeVitesse() const {
-    return boite_de_vitesse;
+const string& Voiture::getBoiteDeVitesse() const {
+    return TableChaines::getInstance().getChaine(boite_de_vitesse);
 }
 
 /**
@@ -76,8 +76,8 @@ int Voiture::getKilometres() const {
  *
  * \return Le type de carburant utilisé par la voiture (essence, diesel, etc.).
  */
-string Voiture::getEssence() const {
-    return essence;
+const string& Voiture::getEssence() const {
+    return TableChaines::getInstance().getChaine(essence);
 }
 
 /**
@@ -105,7 +105,7 @@ float Voiture::getTailleEngin() const {
  * \param b La nouvelle marque à attribuer à la voiture.
  */
 void Voiture::setBrand(const string& b) {
-    brand = b;
+    brand = TableChaines::getInstance().interner(b);
 }
 
 /**
@@ -114,7 +114,7 @@ void Voiture::setBrand(const string& b) {
  * \param m Le nouveau modèle à attribuer à la voiture.
  */
 void Voiture::setModel(const string& m) {
-    model = m;
+    model = TableChaines::getInstance().interner(m);
 }
 
 /**
@@ -132,7 +132,7 @@ void Voiture::setYear(int y) {
  * \param bv Le nouveau type de boîte de vitesses (manuelle, automatique, etc.).
  */
 void Voiture::setBoiteDeVitesse(const string& bv) {
-    boite_de_vitesse = bv;
+    boite_de_vitesse = TableChaines::getInstance().interner(bv);
 }
 
 /**
@@ -150,7 +150,7 @@ void Voiture::setKilometres(int km) {
  * \param e Le type de carburant (essence, diesel, etc.).
  */
 void Voiture::setEssence(const string& e) {
-    essence = e;
+    essence = TableChaines::getInstance().interner(e);
 }
 
 /**
@@ -178,9 +178,9 @@ void Voiture::setTailleEngin(float taille) {
  */
 void Voiture::afficherTout() const {
     cout << endl << endl;
-    Produit::afficherTout();  // Affiche les informations héritées de la classe Produit
-    cout << endl << "Marque: " << brand << "\nModele: " << model << "\nAnnee: " << year
-         << "\nBoîte de Vitesse: " << boite_de_vitesse << "\nKilometres: " << kilometres
-         << "\nEssence: " << essence << "\nMPG: " << mpg
+    afficherCommun();  // Affiche les informations héritées de la classe Produit
+    cout << endl << "Marque: " << getBrand() << "\nModele: " << getModel() << "\nAnnee: " << year
+         << "\nBoîte de Vitesse: " << getBoiteDeVitesse() << "\nKilometres: " << kilometres
+         << "\nEssence: " << getEssence() << "\nMPG: " << mpg
          << "\nTaille du Moteur: " << taille_engin << endl;
 }
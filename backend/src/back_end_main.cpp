@@ -14,19 +14,24 @@
 #include <cstdlib>
 #include <vector>
 #include <barrier>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 #include <memory>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 #include "Vendeur.h"
 #include "Acheteur.h"
 #include "BoiteAuLettres.h"
 #include "Threads_var.h"
 #include "Protocol.h"
+#include "Catalogue.h"
+#include "GenerateurAleatoire.h"
+#include "RepertoireVendeurs.h"
+#include "TableProduits.h"
 #include <math.h>
 #include "back_end_main.h"
-#include <QApplication>
-#include <QMainWindow>
 
 using namespace std;
 
@@ -155,54 +160,83 @@ vector<shared_ptr<BoiteAuLettres>> start_negocier(vector<Acheteur>& acheteur,vec
 
     init_shared_resources_Acheteur(num_threads_achet);
     init_shared_resources_Vendeur(num_threads_ven);
+    RepertoireVendeurs::getInstance().construire(vendeur);
 
-    vector<thread> vendeur_threads;
-    vector<thread> acheteur_threads;
     vector<shared_ptr<BoiteAuLettres>> boite_au_lettres_finales(num_threads_achet);
 
+    //Les agents sont des coroutines reprises par l'Ordonnanceur, pas des threads : on compte celles qui n'ont pas fini
+    mutex mtx_fin;
+    condition_variable cv_fin;
+    int achet_restants = num_threads_achet;
+    int vend_restants = num_threads_ven;
+    auto terminer = [&mtx_fin, &cv_fin](int& restants) {
+        lock_guard<mutex> lock(mtx_fin);
+        restants--;
+        cv_fin.notify_all(); //Sous le verrou : start_negocier peut retourner des que le compte tombe a 0
+    };
+
+    //Chaque negociation s'execute ici jusqu'a sa premiere attente, avant le premier signal
+    vector<Negociation> negociations;
+    negociations.reserve(num_threads_achet + num_threads_ven);
     for (int i = 0; i < num_threads_achet; i++)
     {
-        acheteur_threads.emplace_back(&Acheteur::negocier, &acheteur[i],i,num_threads_achet,ref(boite_au_lettres_finales));
+        negociations.push_back(acheteur[i].negocier(i, num_threads_achet, boite_au_lettres_finales));
+        negociations.back().demarrer([&terminer, &achet_restants] { terminer(achet_restants); });
     }
     for (int z = 0; z < num_threads_ven; z++)
     {
-        vendeur_threads.emplace_back(&Vendeur::negocier, &vendeur[z],z,num_threads_ven);
+        negociations.push_back(vendeur[z].negocier(z));
+        negociations.back().demarrer([&terminer, &vend_restants] { terminer(vend_restants); });
     }
 
+    //Sinon chaque acheteur reveille le suivant quand il a fini
+    bool simultanes = num_threads_achet > 0 && num_threads_ven > 0
+                      && acheteur[0].getBoiteAuLettres(0)->getProtocol()->isAcheteursSimultanes();
+    if (simultanes) {
+        for (int i = 0; i < num_threads_achet; i++) {
+            evenements_Achet[i]->signaler();
+        }
+    } else if (num_threads_achet > 0) {
+        evenements_Achet[0]->signaler();
+    }
 
-        *child_ready_flags_Achet[0]=true;
-        child_Achet_cvs[0]->notify_one();
-        cout<<"Acheteur "<<0<<"notifie (main)";
-
-
-    for (auto& t : acheteur_threads) {
-        t.join();
+    {
+        unique_lock<mutex> lock(mtx_fin);
+        cv_fin.wait(lock, [&achet_restants] { return achet_restants == 0; });
     }
 
     {
-        std::lock_guard<std::mutex> lock(mtx);
         termination_flag->store(true);
-        for (int i = 0; i < vendeur_threads.size(); i++)
+        for (int i = 0; i < num_threads_ven; i++)
         {
-            *child_ready_flags_Vend[i]=true;
-            child_Vend_cvs[i]->notify_one();
+            evenements_Vend[i]->signaler();
         }
     }
 
-    for (auto& t : vendeur_threads) {
-        t.join();
+    {
+        unique_lock<mutex> lock(mtx_fin);
+        cv_fin.wait(lock, [&vend_restants] { return vend_restants == 0; });
     }
 
 
 
     for (int var = 0; var < acheteur.size(); ++var) {
-        if(acheteur[var].getProduit()->getPrix()!=0){
-        auto produit_ptr = acheteur[var].getProduit();
-        if (auto voiture_ptr = std::dynamic_pointer_cast<Voiture>(produit_ptr)) {
-            voit.push_back(voiture_ptr);
+        if(acheteur[var].getPrixAccord()!=0){
+        //Copie sur le tas : le garage ne retient pas l'arene des voitures du vendeur
+        //Le prix convenu n'est porte que par la copie, la voiture du vendeur n'est pas modifiee
+        if (const Voiture* voiture = commeVoiture(acheteur[var].getProduit())) {
+            shared_ptr<Voiture> copie = make_shared<Voiture>(*voiture);
+            copie->setPoignee(PoigneeProduit());
+            copie->figerPrix();
+            copie->setPrix(acheteur[var].getPrixAccord());
+            voit.push_back(copie);
         }
+        //La voiture a deja quitte l'inventaire de son vendeur, a l'accord (Vendeur::negocier)
         }
     }
+    for (Vendeur& v : vendeur) {
+        v.appliquerPrix();
+    }
 
 
     return boite_au_lettres_finales;
@@ -240,87 +274,43 @@ void acheteur_Initialisation(vector<Acheteur> &acheteur,int &num_threads_achet,i
 
 void vendeur_Initialisation(vector<Vendeur>&vendeur  , vector<vector<int>> &param_vendeurs)
 {
-    string categorie_adress="";
-    string cat_name="";
-    vector<string> data;
+    Catalogue& catalogue=Catalogue::getInstance();
     int nbr_lignes=0;
     int ligne_choisi=0;
-    int cat=0,ligne=0;
+    int cat=0;
     int id=0;
-    srand(time(NULL));
+    GenerateurAleatoire aleatoire=GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_INITIALISATION, 0);
+
+    if(!catalogue.estTermine()){
+        cout<<"Attente du chargement du catalogue ("<<catalogue.getProgression()<<"%)"<<endl;
+    }
+    if(!catalogue.charger()){
+        cerr<<"Catalogue vide, aucun produit genere"<<endl;
+    }
+    const CatalogueColonnes& colonnes=catalogue.getColonnes();
+    //Les voitures de tous les vendeurs de la session sont prises dans la meme arene
+    shared_ptr<ArenaSession> arena=make_shared<ArenaSession>();
 
     for (size_t i = 0; i < param_vendeurs.size(); i++) {
         Vendeur ven(i, 1);
+        ven.setArenaProduits(arena);
         ven.setStyle_negociacion(param_vendeurs[i][0]);
         ven.set_tKarma(param_vendeurs[i][2]);
         vendeur.push_back(ven);
-        for (size_t y = 0; y < param_vendeurs[i][1]; y++) {
-
-            cat=rand()%9;
-            switch (cat)
-            {
-            case 0:
-                categorie_adress="../../data/audi.csv";
-                cat_name="Audi";
-                nbr_lignes=10660;
-                break;
-            case 1:
-                categorie_adress="../../data/bmw.csv";
-                cat_name="BMW";
-                nbr_lignes=10780;
-                break;
-            case 2:
-
-                categorie_adress="../../data/ford.csv";
-                nbr_lignes=17960;
-
-                cat_name="Ford";
-                break;
-            case 3:
-                categorie_adress="../../data/hyundi.csv";
-                cat_name="Hyundai";
-                nbr_lignes=4860;
-                break;
-            case 4:
-
-                categorie_adress="../../data/merc.csv";
-                nbr_lignes=13110;
-                cat_name="Mercedes";
-                break;
-            case 5:
-                categorie_adress="../../data/skoda.csv";
-                cat_name="Skoda";
-                nbr_lignes=6260;
-                break;
-            case 6:
-                categorie_adress="../../data/toyota.csv";
-                cat_name="Toyota";
-                nbr_lignes=6730;
-                break;
-            case 7:
-                categorie_adress="../../data/vauxhall.csv";
-                cat_name="Vauxhall";
-                nbr_lignes=13630;
-                break;
-            case 8:
-                categorie_adress="../../data/vw.csv";
-                cat_name="VW";
-                nbr_lignes=15150;
-                break;
-
-            default:
-                break;
+        for (size_t y = 0; y < param_vendeurs[i][1] && colonnes.getNbrLignes()>0; y++) {
 
+            cat=aleatoire.entre(0, colonnes.getNbrMarques()-1);
+            nbr_lignes=colonnes.getNbrLignesMarque(cat);
+            if(nbr_lignes==0){
+                continue;
             }
-            ligne_choisi = (rand() % nbr_lignes) + 2;
-            data = readLineFromCSV(categorie_adress, ligne_choisi);
-            id = ((cat + 1) * 1000) + ligne_choisi;
+            ligne_choisi = colonnes.getDebutMarque(cat) + aleatoire.entre(0, nbr_lignes-1);
+            id = Produit::nouvelIdentifiant(); //La meme ligne peut etre tiree deux fois
 
-            vendeur.back().addVoiture(id, "pas de description", stof(data[2]), "Voiture", "pas d'image", cat_name,
-                                      data[0], stoi(data[1]), data[3], stoi(data[4]), data[5], stoi(data[7]), stoi(data[8]));
+            vendeur.back().addVoitureCatalogue(id, ligne_choisi);
 
-            float min_prix = (rand() % 5000) + 5000;  // Prix min entre 5000 et 10000
-            float max_prix = min_prix + (rand() % 10000) + 5000;  // Max supérieur de 5000 à 15000
+            float min_prix = aleatoire.entre(5000, 9999);  // Prix min entre 5000 et 10000
+            float max_prix = min_prix + aleatoire.entre(5000, 14999);  // Max supérieur de 5000 à 15000
             vendeur.back().setFourchettePrix(min_prix, max_prix);
         }
     }
@@ -347,6 +337,12 @@ void bal_Initialisation(int& num_threads_ven,int& num_threads_achet,vector<Vende
 }
 
 vector<string> readLineFromCSV(const string& filename, int lineNumber) {
+    Catalogue& catalogue=Catalogue::getInstance();
+    int cat=catalogue.estCharge() ? catalogue.trouverCategorie(filename) : -1;
+    if(cat>=0){
+        return catalogue.getChampsFichier(cat, lineNumber);
+    }
+
     ifstream file(filename);
     string line;
     int currentLine = 0;
@@ -379,42 +375,31 @@ vector<string> readLineFromCSV(const string& filename, int lineNumber) {
 }
 
 void recuperer_tous_produits(vector<Produits_dispos> &p_d, vector<Vendeur> &vendeurs) {
-    string m = "", b = "";
     p_d.clear();
-    int ID;
-    int prx = 0;
-    vector<shared_ptr<Produit>> temp;
-    bool est_dedans = false;
+    float prx = 0;
+    unordered_map<uint64_t, int> position; // identifiants (marque, modele) -> indice dans p_d
 
     // Parcours des vendeurs
     for (int i = 0; i < vendeurs.size(); i++) {
-        temp = vendeurs[i].getProduits();
+        const vector<shared_ptr<Produit>>& temp = vendeurs[i].getProduits();
         for (int y = 0; y < temp.size(); y++) {
-            auto voit = dynamic_pointer_cast<Voiture>(temp[y]);
-            ID = voit->getId();
-            m = voit->getModel();
-            b = voit->getBrand();
-            prx = voit->getPrix();
-
-            // Vérification si le produit est déjà dans la liste
-            est_dedans = false;
-            for (int n = 0; n < p_d.size(); n++) {
-                if (p_d[n].est_egale(m, b)) {
-                    p_d[n].nbr++;                // Compte le nombre d'occurrences
-                    p_d[n].prix_min = std::min(p_d[n].prix_min, static_cast<float>(prx));
-                    p_d[n].prix_max = std::max(static_cast<float>(p_d[n].prix_max), static_cast<float>(prx));  // Mise à jour du prix maximal
-                    est_dedans = true;
-                    break;
-                }
+            prx = static_cast<int>(temp[y]->getPrix());
+
+            // Les produits sont regroupes par identifiants internes, les chaines ne sont lues que pour l'affichage
+            const Voiture* voit = commeVoiture(temp[y].get());
+            uint64_t cle = (static_cast<uint64_t>(voit->getIdBrand()) << 32) | voit->getIdModel();
+            auto it = position.find(cle);
+            if (it == position.end()) {
+                position[cle] = static_cast<int>(p_d.size());
+                p_d.push_back(Produits_dispos(voit->getBrand(), voit->getModel(), prx));
+                continue;
             }
 
-            // Si le produit n'est pas encore dans la liste, on l'ajoute
-            if (!est_dedans) {
-                p_d.push_back(Produits_dispos(b, m, prx)); // Création avec prix initial
-                p_d.back().prix_min = prx;  // Initialisation de la fourchette de prix
-                p_d.back().prix_max = prx;  // Initialisation de la fourchette de prix
-                p_d.back().nbr = 1;         // Une première occurrence
-            }
+            // Si le produit est deja dans la liste, on met a jour le compte et la fourchette de prix
+            int n = it->second;
+            p_d[n].nbr++;
+            p_d[n].prix_min = std::min(p_d[n].prix_min, prx);
+            p_d[n].prix_max = std::max(p_d[n].prix_max, prx);
         }
     }
 
@@ -459,11 +444,11 @@ void affichage_choix_Produits_dispos(vector<Produits_dispos>& p_d, int& num_ache
 //N'est plus utilise
 void affichage_finales(vector<shared_ptr<BoiteAuLettres>> bal) {
     for (int i = 0; i < bal.size(); i++) {
-        if (bal[i]->dernierMessage()->getOffre() == 0) {
+        if (bal[i]->dernierMessage().getOffre() == 0) {
             cout << "Désolée, les négociations n'ont pas terminé avec un accord.\nVoici le protocole des messages : \n";
         } else {
-            float prix_offre = bal[i]->dernierMessage()->getOffre();
-            shared_ptr<Produit> produit = bal[i]->dernierMessage()->getProduit();
+            float prix_offre = bal[i]->dernierMessage().getOffre();
+            Produit* produit = bal[i]->dernierMessage().getProduit();
 
             if (prix_offre >= produit->getPrixMin() && prix_offre <= produit->getPrixMax()) {
                 cout << "Bravo !! Vous avez acheté le produit pour " << prix_offre << " €.\nVoici le protocole des messages : \n";
@@ -474,3 +459,77 @@ void affichage_finales(vector<shared_ptr<BoiteAuLettres>> bal) {
         }
     }
 }
+
+/**
+ * @brief Lance une session de négociation complète sans interface graphique.
+ *
+ * Les vendeurs sont ceux créés par défaut par l'interface. Chaque acheteur choisit un produit disponible, un prix
+ * cible dans sa fourchette et une stratégie, tirés dans le flux FLUX_SANS_INTERFACE : avec la même graine de
+ * session, deux exécutions font les mêmes choix. Les achats, puis les statistiques du répertoire des vendeurs et
+ * de l'arène des voitures, sont affichés à la fin de la session.
+ * @param nbr_acheteurs Nombre d'acheteurs
+ * @param acheteurs_simultanes True pour que tous les acheteurs négocient en même temps
+ * @param capacite_vendeur Nombre de négociations qu'un vendeur peut mener en même temps
+ * @return 0 si la session a pu être lancée, 1 sinon
+ */
+int lancer_sans_interface(int nbr_acheteurs, bool acheteurs_simultanes, int capacite_vendeur){
+    cout<<"Graine de session: "<<GenerateurAleatoire::getGraineSession()<<endl;
+
+    vector<vector<int>> param_vendeurs = {{1, 10, 3}, {2, 34, 4}, {1, 123, 4}, {2, 234, 4}, {1, 1, 4}};
+    vector<Vendeur> vendeurs;
+    vendeur_Initialisation(vendeurs, param_vendeurs);
+    vector<Produits_dispos> p_d;
+    recuperer_tous_produits(p_d, vendeurs);
+    if(p_d.empty() || nbr_acheteurs <= 0){
+        cerr<<"Aucun produit ou aucun acheteur, session annulee"<<endl;
+        return 1;
+    }
+
+    shared_ptr<Protocol> protocole = make_shared<Protocol>();
+    protocole->setNbrTours(5);
+    protocole->setNbrOblAchet(4);
+    protocole->setPenalite(5);
+    protocole->setNegMemeTemps(3);
+    protocole->setAcheteursSimultanes(acheteurs_simultanes);
+    protocole->setCapaciteVendeur(capacite_vendeur);
+
+    int nbr_vendeurs = vendeurs.size();
+    vector<Acheteur> acheteurs;
+    acheteur_Initialisation(acheteurs, nbr_acheteurs, nbr_vendeurs);
+    bal_Initialisation(nbr_vendeurs, nbr_acheteurs, vendeurs, acheteurs, protocole);
+
+    GenerateurAleatoire aleatoire = GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_SANS_INTERFACE, 0);
+    vector<PoigneeProduit> recherches;
+    for (int i = 0; i < nbr_acheteurs; i++) {
+        const Produits_dispos& choix = p_d[aleatoire.entre(0, p_d.size() - 1)];
+        shared_ptr<Voiture> voiture = make_shared<Voiture>();
+        voiture->setBrand(choix.marque);
+        voiture->setModel(choix.modele);
+        voiture->setPrix(aleatoire.entre(choix.prix_min, choix.prix_max));
+        acheteurs[i].setStrat(aleatoire.entre(1, 5));
+        recherches.push_back(TableProduits::getInstance().enregistrer(voiture));
+        acheteurs[i].setProd(recherches.back());
+    }
+
+    vector<shared_ptr<Voiture>> achats;
+    start_negocier(acheteurs, vendeurs, achats);
+
+    cout<<endl<<achats.size()<<" voiture(s) achetee(s) sur "<<nbr_acheteurs<<endl;
+    for (const auto& v : achats) {
+        cout<<v->getId()<<" "<<v->getBrand()<<v->getModel()<<" "<<v->getPrix()<<endl;
+    }
+    cout << "Repertoire: " << RepertoireVendeurs::getInstance().getRecherchesEnvoyees() << " recherche(s) envoyee(s), "
+         << RepertoireVendeurs::getInstance().getRecherchesEvitees() << " evitee(s)" << endl;
+    if (vendeurs[0].getArenaProduits()) {
+        vendeurs[0].getArenaProduits()->afficherStatistiques("voitures");
+    }
+
+    //Fin de session : recherches et inventaires quittent la table, les achats restent dans achats
+    for (PoigneeProduit r : recherches) {
+        TableProduits::getInstance().liberer(r);
+    }
+    for (Vendeur& v : vendeurs) {
+        v.libererProduits();
+    }
+    return 0;
+}
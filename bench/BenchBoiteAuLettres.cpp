@@ -0,0 +1,97 @@
+/**
+ * @file BenchBoiteAuLettres.cpp
+ * @brief Débit d'une boîte aux lettres, avec et sans historique.
+ *
+ * Trois mesures sur une seule boîte :
+ *  - écriture : un thread laisse les messages des deux sens à tour de rôle ;
+ *  - lecture : dernierMessage, getSize et getNbrMessages sur une boîte déjà remplie ;
+ *  - aller-retour : un acheteur et un vendeur, chacun dans son thread, s'écrivent à tour de rôle en
+ *    attendant activement le message de l'autre, comme pendant une négociation.
+ *
+ * Usage : BenchBoiteAuLettres [nombre de messages]
+ */
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include "BoiteAuLettres.h"
+
+using namespace std;
+
+namespace {
+
+template <class F>
+double mesurer(F f) {
+    auto debut = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - debut).count();
+}
+
+void afficher(const char* nom, bool historique, int nbr, double ms) {
+    cout << nom << (historique ? " (historique)" : " (sans historique)") << ": " << nbr << " operations en "
+         << ms << " ms, " << nbr / ms / 1000.0 << " M/s" << endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+    int nbr = argc > 1 ? atoi(argv[1]) : 200000;
+    shared_ptr<Protocol> protocole = make_shared<Protocol>();
+    //L'historique garde au plus 64 * 1024 messages
+    int nbr_historique = min(nbr, 60000);
+
+    for (bool historique : {false, true}) {
+        int n = historique ? nbr_historique : nbr;
+
+        BoiteAuLettres ecriture(protocole, historique);
+        double ms = mesurer([&]() {
+            for (int i = 0; i < n; i++) {
+                Message m(i % 2, 0, Verbe::OFFER, static_cast<float>(i), PoigneeProduit());
+                ecriture.laisserMessage(m, i % 2 ? BoiteAuLettres::Emetteur::VENDEUR : BoiteAuLettres::Emetteur::ACHETEUR);
+            }
+        });
+        afficher("ecriture", historique, n, ms);
+
+        float somme = 0.0f;
+        ms = mesurer([&]() {
+            for (int i = 0; i < nbr; i++) {
+                somme += ecriture.dernierMessage().getOffre() + ecriture.getSize()
+                         + ecriture.getNbrMessages(BoiteAuLettres::Emetteur::ACHETEUR);
+            }
+        });
+        afficher("lecture", historique, nbr, ms);
+
+        BoiteAuLettres echange(protocole, historique);
+        int tours = n / 2;
+        ms = mesurer([&]() {
+            thread vendeur([&]() {
+                for (int i = 0; i < tours; i++) {
+                    while (echange.getNbrMessages(BoiteAuLettres::Emetteur::ACHETEUR) <= i) {
+                        this_thread::yield();
+                    }
+                    Message m(1, 0, Verbe::OFFER, echange.dernierMessage().getOffre() + 1, PoigneeProduit());
+                    echange.laisserMessage(m, BoiteAuLettres::Emetteur::VENDEUR);
+                }
+            });
+            for (int i = 0; i < tours; i++) {
+                while (echange.getNbrMessages(BoiteAuLettres::Emetteur::VENDEUR) < i) {
+                    this_thread::yield();
+                }
+                Message m(0, 1, Verbe::OFFER, static_cast<float>(2 * i), PoigneeProduit());
+                echange.laisserMessage(m, BoiteAuLettres::Emetteur::ACHETEUR);
+            }
+            vendeur.join();
+        });
+        afficher("aller-retour", historique, 2 * tours, ms);
+        if (echange.getSize() != 2 * tours) {
+            cerr << "aller-retour incomplet" << endl;
+            return 1;
+        }
+        //Empeche le compilateur de supprimer les lectures
+        if (somme < 0) {
+            cout << somme << endl;
+        }
+    }
+    return 0;
+}
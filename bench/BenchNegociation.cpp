@@ -0,0 +1,126 @@
+/**
+ * @file BenchNegociation.cpp
+ * @brief Durée d'une session de négociation, agents en coroutines ou en threads.
+ *
+ * Le même panier (mêmes vendeurs, mêmes acheteurs, mêmes choix, tirés avec la même graine) est négocié avec
+ * chaque exécution de Negociation : coroutines reprises par l'Ordonnanceur, puis un thread bloquant par agent.
+ * Acheteurs l'un après l'autre, les achats doivent être les mêmes dans les deux exécutions ; acheteurs en
+ * même temps, seul leur nombre est affiché.
+ *
+ * Usage : BenchNegociation <dossier data> [vendeurs] [acheteurs] [graine]
+ */
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include "back_end_main.h"
+#include "Catalogue.h"
+#include "GenerateurAleatoire.h"
+#include "Negociation.h"
+#include "TableProduits.h"
+
+using namespace std;
+
+namespace {
+
+struct Resultat {
+    double ms = 0.0;
+    size_t nbr_achats = 0;
+    string achats;      //Sans les identifiants d'annonce, qui changent d'une session a l'autre
+};
+
+Resultat session(uint64_t graine, int nbr_vendeurs, int nbr_acheteurs, bool simultanes) {
+    GenerateurAleatoire::setGraineSession(graine);
+    vector<vector<int>> param_vendeurs;
+    for (int i = 0; i < nbr_vendeurs; i++) {
+        param_vendeurs.push_back({1 + i % 5, 10, 4});
+    }
+    vector<Vendeur> vendeurs;
+    vendeur_Initialisation(vendeurs, param_vendeurs);
+    vector<Produits_dispos> p_d;
+    recuperer_tous_produits(p_d, vendeurs);
+
+    shared_ptr<Protocol> protocole = make_shared<Protocol>();
+    protocole->setNbrTours(5);
+    protocole->setNbrOblAchet(4);
+    protocole->setPenalite(5);
+    protocole->setNegMemeTemps(3);
+    protocole->setAcheteursSimultanes(simultanes);
+
+    vector<Acheteur> acheteurs;
+    acheteur_Initialisation(acheteurs, nbr_acheteurs, nbr_vendeurs);
+    bal_Initialisation(nbr_vendeurs, nbr_acheteurs, vendeurs, acheteurs, protocole);
+
+    GenerateurAleatoire aleatoire = GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_SANS_INTERFACE, 0);
+    vector<PoigneeProduit> recherches;
+    for (int i = 0; i < nbr_acheteurs && !p_d.empty(); i++) {
+        const Produits_dispos& choix = p_d[aleatoire.entre(0, p_d.size() - 1)];
+        shared_ptr<Voiture> voiture = make_shared<Voiture>();
+        voiture->setBrand(choix.marque);
+        voiture->setModel(choix.modele);
+        voiture->setPrix(aleatoire.entre(choix.prix_min, choix.prix_max));
+        acheteurs[i].setStrat(aleatoire.entre(1, 5));
+        recherches.push_back(TableProduits::getInstance().enregistrer(voiture));
+        acheteurs[i].setProd(recherches.back());
+    }
+
+    Resultat r;
+    vector<shared_ptr<Voiture>> achats;
+    auto debut = chrono::steady_clock::now();
+    start_negocier(acheteurs, vendeurs, achats);
+    r.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - debut).count();
+    r.nbr_achats = achats.size();
+    ostringstream texte;
+    for (const auto& v : achats) {
+        texte << v->getBrand() << v->getModel() << " " << v->getPrix() << "\n";
+    }
+    r.achats = texte.str();
+
+    for (PoigneeProduit h : recherches) {
+        TableProduits::getInstance().liberer(h);
+    }
+    for (Vendeur& v : vendeurs) {
+        v.libererProduits();
+    }
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <dossier data> [vendeurs] [acheteurs] [graine]" << endl;
+        return 2;
+    }
+    int nbr_vendeurs = argc > 2 ? atoi(argv[2]) : 200;
+    int nbr_acheteurs = argc > 3 ? atoi(argv[3]) : 20;
+    uint64_t graine = argc > 4 ? strtoull(argv[4], nullptr, 10) : 42;
+    if (!Catalogue::getInstance().charger(argv[1])) {
+        cerr << "catalogue introuvable dans " << argv[1] << endl;
+        return 1;
+    }
+
+    const pair<Negociation::Execution, const char*> executions[] = {
+        {Negociation::Execution::ORDONNANCEUR, "coroutines"},
+        {Negociation::Execution::THREADS, "threads"},
+    };
+    vector<Resultat> resultats;
+    for (bool simultanes : {false, true}) {
+        for (const auto& [execution, nom] : executions) {
+            Negociation::setExecution(execution);
+            resultats.push_back(session(graine, nbr_vendeurs, nbr_acheteurs, simultanes));
+            const Resultat& r = resultats.back();
+            cout << nom << (simultanes ? " (acheteurs simultanes)" : " (acheteurs l'un apres l'autre)") << ": "
+                 << nbr_vendeurs << " vendeurs, " << nbr_acheteurs << " acheteurs, " << r.nbr_achats
+                 << " achat(s) en " << r.ms << " ms" << endl;
+        }
+    }
+    Negociation::setExecution(Negociation::Execution::ORDONNANCEUR);
+
+    if (resultats[0].achats != resultats[1].achats) {
+        cerr << "achats differents selon l'execution" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <QMainWindow>
 #include <QStackedWidget>
 #include <QMenuBar>
+#include <QTimer>
 #include "StartScreen.h"
 #include "Parametres.h"
 #include "Vendeur.h"
@@ -30,7 +31,7 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
-    void updateProtocol(int* nbr_rounds, int* tours_limites, int* penalite, int* neg_simult, bool* pt_differ);
+    void updateProtocol(int* nbr_rounds, int* tours_limites, int* penalite, int* neg_simult, bool* pt_differ, bool* simultanes, int* capacite);
     void updateVendeurs(std::vector<std::vector<int>>& vendeurs_param_ptr);
 
 private slots:
@@ -39,9 +40,12 @@ private slots:
     void showGarage();
     void showParametres();
     void showVente();
-    void negocier(const std::vector<std::tuple<Voiture, int>>& product);
+    void negocier(const std::vector<std::tuple<PoigneeProduit, int>>& product);
+    void verifierChargement();
 
 private:
+    void attendreCatalogue();
+
     QStackedWidget *stackedWidget;
     Parametres *parameterWindow;
     QWidget *mainMenuScreen;
@@ -52,12 +56,14 @@ private:
     Garage *garage = nullptr;
     StartScreen *startScreen; // Déclaration du StartScreen comme membre
     Vente *vente = nullptr;
+    QTimer *timerChargement = nullptr; // Suit le chargement du catalogue en arrière-plan
 
     // Données pour la logique
     int nbr_tours;
     std::vector<std::vector<int>> param_vendeurs;
     std::vector<Vendeur> vendeurs;
     std::vector<Acheteur> acheteurs;
+    std::vector<PoigneeProduit> recherches; // Voitures du dernier panier, liberees a la negociation suivante
     std::vector<Produits_dispos> p_d;
     std::vector<std::vector<Produits_dispos>> produits_selectionnees;
     std::shared_ptr<Protocol> protocol;
@@ -32,7 +32,7 @@ private slots:
 
 signals:
     void submitVendorClicked(vector<vector<int>>& vendeurs_param_ptr);
-    void submitProtocolClicked(int* nbr_rounds, int* tours_limites, int* penalite, int* neg_simult,bool* pt_differ);
+    void submitProtocolClicked(int* nbr_rounds, int* tours_limites, int* penalite, int* neg_simult,bool* pt_differ, bool* simultanes, int* capacite);
 
 private:
     Ui::Parametres *ui;
@@ -47,6 +47,8 @@ private:
     int* penalite;
     int* neg_simult;
     bool pt_differ;
+    bool acheteurs_simultanes;
+    int capacite_vendeur;
     std::vector<std::vector<int>>* vendeurs_param_ptr;
 };
 
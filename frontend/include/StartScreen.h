@@ -20,6 +20,7 @@ public:
     void playButtonSound();  // Méthode publique pour jouer un son de bouton
     QPushButton *startButton;
     QPushButton* getStartButton() const;  // Getter pour startButton
+    void setProgressionChargement(int pourcentage);  // Avancement du chargement du catalogue
 
 
 private slots:
@@ -30,6 +31,7 @@ signals:
 
 private:
     QLabel *welcomeText;
+    QLabel *chargementText;
     QLabel *backgroundLabel;
     QMediaPlayer *mediaPlayer;  // Pour lire le son
     QAudioOutput *audioOutput; // Pour gérer la sortie audio
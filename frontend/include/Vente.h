@@ -20,7 +20,7 @@ private slots:
 private:
     QTableWidget* tableWidgetVente;
     Garage* garage;
-    std::vector<std::shared_ptr<Voiture>> voituresEnVente;
+    std::vector<PoigneeProduit> voituresEnVente;  // Poignees propres a la vente dans TableProduits
 
     void displayVoituresVente();  // Afficher les voitures en vente
     void afficherGarageDialog(); // Afficher le garage et gérer la sélection
@@ -23,7 +23,7 @@ public:
     void setBoites(const std::vector<Acheteur> &boites, const std::vector<Vendeur> &vendeur);
 private:
     void createChatTabs();  // Creates the tabs for each BoiteAuLettres
-    void showDetails(std::shared_ptr<Message> message);
+    void showDetails(const Message& message);
     void showProtocol(std::shared_ptr<Protocol> prot);
     void showAcheteurDetails(shared_ptr<Acheteur> a);
     void showVendeurDetails(shared_ptr<Vendeur> v);
@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 #include "Voiture.h"
+#include "TableProduits.h"
 
 class QTableWidget;
 
@@ -15,7 +16,7 @@ class Garage : public QWidget {
 
 private:
     QTableWidget* tableWidget;
-    std::vector<std::shared_ptr<Voiture>> voitures;
+    std::vector<PoigneeProduit> voitures;   // Poignees propres au garage dans TableProduits
 
 public:
     explicit Garage(QWidget* parent = nullptr);
@@ -24,11 +25,11 @@ public:
     void displayVoitures();
     void removeVoiture(int id);
     // Obtenir la liste de toutes les voitures
-    std::vector<std::shared_ptr<Voiture>> getVoiture() const;
+    std::vector<PoigneeProduit> getVoiture() const;
 
     // Trouver un produit par modèle et marque
-    std::shared_ptr<Voiture> trouverVoitue(const std::string& marque, const std::string& modele);
-    std::vector<std::shared_ptr<Voiture>> getAllVoitures() const;
+    PoigneeProduit trouverVoitue(const std::string& marque, const std::string& modele);
+    const std::vector<PoigneeProduit>& getAllVoitures() const;
     // Afficher tous les produits disponibles
     void afficherProduits() const;
 
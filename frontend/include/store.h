@@ -11,6 +11,7 @@
 #include <tuple>
 #include <QLabel>
 #include "back_end_main.h"
+#include "TableProduits.h"
 
 namespace Ui {
 class Store;
@@ -33,7 +34,7 @@ public:
 
 signals:
     void productSelected(const Produits_dispos &product, double maxBid);
-    void cartValidated(const std::vector<std::tuple<Voiture, int>>& cartDetails);
+    void cartValidated(const std::vector<std::tuple<PoigneeProduit, int>>& cartDetails);
 
 private:
     Ui::Store *ui;
@@ -42,7 +43,7 @@ private:
     QWidget *productsContainer;
     QVBoxLayout *productsLayout;
     std::vector<Produits_dispos> originalProducts;   // All available products
-    std::vector<std::tuple<Voiture,int>> cart;  // Updated cart to store tuples of product, price, strategy
+    std::vector<std::tuple<PoigneeProduit,int>> cart;  // Voitures recherchees (poignees dans TableProduits) et strategie
     void displayProducts(const std::vector<Produits_dispos>& products);  // Displays products based on filter or full list
     void ajouterProduit();
     void showProtocol();
@@ -2,6 +2,9 @@
 #include <QMenu>
 #include <QAction>
 #include <QVBoxLayout>
+#include <QProgressDialog>
+#include <QCoreApplication>
+#include <QThread>
 #include <vector>
 #include "Parametres.h"
 #include "back_end_main.h"
@@ -11,6 +14,7 @@
 #include "chats.h"
 #include "Protocol.h"
 #include "StartScreen.h"
+#include "Catalogue.h"
 #include <string.h>
 #include <memory>
 
@@ -74,9 +78,15 @@ MainWindow::MainWindow(QWidget *parent)
 
     bool f = true;
     int a = 0;
-    std::vector<std::vector<int>> temp;
-    updateProtocol(&a, &a, &a, &a, &f);
-    updateVendeurs(temp);
+    bool simultanes = false;
+    int capacite = 1;
+    updateProtocol(&a, &a, &a, &a, &f, &simultanes, &capacite);
+
+    // Les vendeurs par défaut sont créés dès que le catalogue, chargé en arrière-plan, est prêt
+    Catalogue::getInstance().precharger();
+    timerChargement = new QTimer(this);
+    connect(timerChargement, &QTimer::timeout, this, &MainWindow::verifierChargement);
+    timerChargement->start(50);
 
     // Jouer la musique au démarrage
     startScreen->playStartupSound();
@@ -85,6 +95,50 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow() {}
 
+/**
+ * @brief Suit le chargement du catalogue lancé au démarrage.
+ *
+ * Appelée périodiquement pendant l'affichage de l'écran de démarrage. Une fois le catalogue chargé, les vendeurs
+ * par défaut sont créés sans changer l'écran affiché, sauf si l'utilisateur a déjà soumis ses propres vendeurs.
+ */
+void MainWindow::verifierChargement() {
+    Catalogue& catalogue = Catalogue::getInstance();
+    startScreen->setProgressionChargement(catalogue.getProgression());
+    if (!catalogue.estTermine()) {
+        return;
+    }
+    timerChargement->stop();
+    if (!vendeurs.empty()) {
+        return;
+    }
+    QWidget *courant = stackedWidget->currentWidget();
+    std::vector<std::vector<int>> temp;
+    updateVendeurs(temp);
+    stackedWidget->setCurrentWidget(courant);
+}
+
+/**
+ * @brief Attend la fin du chargement du catalogue s'il est encore en cours, en affichant son avancement.
+ *
+ * Ne fait rien si le catalogue est déjà chargé, ce qui est le cas habituel après l'écran de démarrage.
+ */
+void MainWindow::attendreCatalogue() {
+    Catalogue& catalogue = Catalogue::getInstance();
+    if (catalogue.estTermine()) {
+        return;
+    }
+    timerChargement->stop();
+    QProgressDialog dialogue("Chargement du catalogue...", QString(), 0, 100, this);
+    dialogue.setWindowModality(Qt::WindowModal);
+    dialogue.setMinimumDuration(0);
+    while (!catalogue.estTermine()) {
+        dialogue.setValue(catalogue.getProgression());
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        QThread::msleep(20);
+    }
+    startScreen->setProgressionChargement(100);
+}
+
 /**
  * @brief Affiche la fenêtre des paramètres.
  *
@@ -156,9 +210,12 @@ void MainWindow::showVente() {
  * Cette fonction initialise les acheteurs et les vendeurs, configure la négociation,
  * et affiche le résultat dans le garage et les chats.
  *
- * @param product Liste des produits choisis par l'utilisateur.
+ * Les voitures recherchées lors de la négociation précédente sont libérées de TableProduits : les messages
+ * qui les désignaient ne sont plus affichés, les chats étant remplacés à la fin de cette négociation.
+ *
+ * @param product Liste des produits choisis par l'utilisateur (poignées dans TableProduits) et stratégies.
  */
-void MainWindow::negocier(const std::vector<std::tuple<Voiture, int>>& product) {
+void MainWindow::negocier(const std::vector<std::tuple<PoigneeProduit, int>>& product) {
 
     qDebug() <<"Debug 1";
     int achet_num = product.size();
@@ -166,6 +223,10 @@ void MainWindow::negocier(const std::vector<std::tuple<Voiture, int>>& product)
     qDebug() <<"Debug 2";
 
     acheteurs.clear();
+    for (PoigneeProduit r : recherches) {
+        TableProduits::getInstance().liberer(r);
+    }
+    recherches.clear();
 
     acheteur_Initialisation(acheteurs, achet_num, vendeurs_size);
 
@@ -182,9 +243,9 @@ void MainWindow::negocier(const std::vector<std::tuple<Voiture, int>>& product)
     qDebug() <<"Debug 4";
 
     for (int var = 0; var < achet_num; ++var) {
-        shared_ptr<Voiture> p = std::make_shared<Voiture>(std::get<0>(product[var]));
         acheteurs[var].setStrat(std::get<1>(product[var]));
-        acheteurs[var].setProd(p);
+        acheteurs[var].setProd(std::get<0>(product[var]));
+        recherches.push_back(std::get<0>(product[var]));
         qDebug() << acheteurs[var].getStrat();
     }
 
@@ -209,8 +270,10 @@ void MainWindow::negocier(const std::vector<std::tuple<Voiture, int>>& product)
  * @param penalite Pénalité pour les tours dépassés.
  * @param neg_simult Nombre de négociations simultanées.
  * @param pt_differ Indicateur de différenciation dans la négociation.
+ * @param simultanes True pour que tous les acheteurs négocient en même temps.
+ * @param capacite Nombre de négociations qu'un vendeur peut mener en même temps.
  */
-void MainWindow::updateProtocol(int* nbr_rounds, int* tours_limites, int* penalite, int* neg_simult, bool* pt_differ) {
+void MainWindow::updateProtocol(int* nbr_rounds, int* tours_limites, int* penalite, int* neg_simult, bool* pt_differ, bool* simultanes, int* capacite) {
     if (*nbr_rounds == 0) {
         *nbr_rounds = 5;
     }
@@ -228,19 +291,24 @@ void MainWindow::updateProtocol(int* nbr_rounds, int* tours_limites, int* penali
     protocol->setPenalite(*penalite);
     protocol->setNegMemeTemps(*neg_simult);
     protocol->setDifferer(pt_differ);
+    protocol->setAcheteursSimultanes(*simultanes);
+    protocol->setCapaciteVendeur(*capacite);
 
     qDebug() << "Protocol parameters updated:"
              << "nbr_tours:" << *nbr_rounds
              << "tours_limites:" << *tours_limites
              << "penalite:" << *penalite
              << "neg_simult:" << *neg_simult
-             << "differ:" << pt_differ;
+             << "differ:" << pt_differ
+             << "simultanes:" << *simultanes
+             << "capacite:" << *capacite;
 }
 
 /**
  * @brief Met à jour les vendeurs avec les paramètres fournis.
  *
  * Cette fonction initialise les vendeurs avec les nouveaux paramètres donnés et met à jour les produits du magasin.
+ * Si le catalogue est encore en cours de chargement, elle attend sa fin en affichant l'avancement.
  *
  * @param vendeurs_param_ptr Paramètres des vendeurs.
  */
@@ -253,6 +321,10 @@ void MainWindow::updateVendeurs(std::vector<std::vector<int>>& vendeurs_param_pt
         (vendeurs_param_ptr)[3] = {2, 234, 4};
         (vendeurs_param_ptr)[4] = {1, 1,4};
     }
+    attendreCatalogue();
+    for (Vendeur& v : vendeurs) {
+        v.libererProduits();
+    }
     vendeurs.clear();
     vendeur_Initialisation(vendeurs,vendeurs_param_ptr);
     recuperer_tous_produits(p_d,vendeurs);
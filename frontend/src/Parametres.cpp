@@ -5,6 +5,7 @@
 
 #include "Parametres.h"
 #include "ui_Parametres.h"
+#include "GenerateurAleatoire.h"
 #include <vector>
 #include <QLabel>
 #include <QComboBox>
@@ -34,7 +35,9 @@ Parametres::Parametres(QWidget *parent, int* nbr_tours, std::vector<std::vector<
     tours_limites(new int(0)),  // Initialisation à une nouvelle valeur entière 0
     penalite(new int(0)),      // Initialisation de même pour les autres variables
     neg_simult(new int(0)),
-    pt_differ(false)
+    pt_differ(false),
+    acheteurs_simultanes(false),
+    capacite_vendeur(1)
 {
     ui->setupUi(this);
 
@@ -51,6 +54,9 @@ Parametres::Parametres(QWidget *parent, int* nbr_tours, std::vector<std::vector<
         *nbr_tours_ptr = value;
     });
 
+    // Graine de session actuelle, pour pouvoir rejouer une exécution
+    ui->graine->setValue(static_cast<int>(GenerateurAleatoire::getGraineSession()));
+
     connect(ui->protocolSubmitButton, &QPushButton::clicked, this, &Parametres::onRoundsButtonClicked);
 
     connect(ui->submitButton, &QPushButton::clicked, this, &Parametres::onSubmit);
@@ -155,9 +161,12 @@ void Parametres::onRoundsButtonClicked()
     *penalite = ui->pen->value();
     *neg_simult = ui->nbr_sim->value();
     pt_differ = false;
+    GenerateurAleatoire::setGraineSession(ui->graine->value()); // Pour les prochains vendeurs et acheteurs
+    acheteurs_simultanes = ui->simultanes->isChecked();
+    capacite_vendeur = ui->capacite->value();
 
     // Émission du signal avec les valeurs mises à jour
-    emit submitProtocolClicked(nbr_tours_ptr, tours_limites, penalite, neg_simult, &pt_differ);
+    emit submitProtocolClicked(nbr_tours_ptr, tours_limites, penalite, neg_simult, &pt_differ, &acheteurs_simultanes, &capacite_vendeur);
 
 }
 
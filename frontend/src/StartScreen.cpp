@@ -50,6 +50,11 @@ StartScreen::StartScreen(QWidget *parent) : QWidget(parent),
     // Pour forcer l'élargissement du texte et remplir la largeur de l'écran
     welcomeText->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
 
+    // Avancement du chargement du catalogue, masqué une fois terminé
+    chargementText = new QLabel("Chargement du catalogue...", this);
+    chargementText->setStyleSheet("font-size: 14px; color: black; background-color: rgba(255, 255, 255, 0.7);");
+    chargementText->setAlignment(Qt::AlignCenter);
+
     // Bouton pour commencer
     startButton = new QPushButton("Let's go ! ", this);
     startButton->setStyleSheet("font-size: 22px; color: Black; padding: 1px; background-color: rgba(255, 255, 255, 0.7);");
@@ -58,6 +63,7 @@ StartScreen::StartScreen(QWidget *parent) : QWidget(parent),
     // Agencement vertical
     QVBoxLayout *layout = new QVBoxLayout(this);
     layout->addWidget(welcomeText, 0, Qt::AlignTop | Qt::AlignHCenter);  // Positionner le texte en haut et centré
+    layout->addWidget(chargementText, 0, Qt::AlignBottom | Qt::AlignHCenter);
     layout->addWidget(startButton, 0, Qt::AlignBottom | Qt::AlignHCenter);  // Positionner le bouton en bas et centré
     layout->setSpacing(20);  // Espacement entre le texte et le bouton
     setLayout(layout);
@@ -74,6 +80,7 @@ StartScreen::~StartScreen() {
     // Libérer les ressources
     delete backgroundLabel;
     delete welcomeText;
+    delete chargementText;
     delete startButton;
     delete mediaPlayer;
     delete audioOutput;
@@ -132,3 +139,13 @@ void StartScreen::playButtonSound() {
 QPushButton* StartScreen::getStartButton() const {
     return startButton;
 }
+
+/**
+ * @brief Affiche l'avancement du chargement du catalogue, lancé en arrière-plan au démarrage.
+ * Le texte est masqué une fois le chargement terminé.
+ * @param pourcentage L'avancement, de 0 à 100.
+ */
+void StartScreen::setProgressionChargement(int pourcentage) {
+    chargementText->setText(QString("Chargement du catalogue... %1 %").arg(pourcentage));
+    chargementText->setVisible(pourcentage < 100);
+}
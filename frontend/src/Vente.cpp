@@ -31,7 +31,10 @@ Vente::Vente(Garage* garage, QWidget* parent)
 void Vente::displayVoituresVente() {
     tableWidgetVente->setRowCount(static_cast<int>(voituresEnVente.size()));
     for (size_t row = 0; row < voituresEnVente.size(); ++row) {
-        auto voiture = voituresEnVente[row];
+        const Voiture* voiture = commeVoiture(TableProduits::getInstance().obtenir(voituresEnVente[row]));
+        if (voiture == nullptr) {
+            continue;
+        }
         tableWidgetVente->setItem(static_cast<int>(row), 0, new QTableWidgetItem(QString::number(voiture->getId())));
         tableWidgetVente->setItem(static_cast<int>(row), 1, new QTableWidgetItem(QString::fromStdString(voiture->getBrand())));
         tableWidgetVente->setItem(static_cast<int>(row), 2, new QTableWidgetItem(QString::fromStdString(voiture->getModel())));
@@ -63,11 +66,14 @@ void Vente::afficherGarageDialog() {
     garageTable->setColumnCount(3);
     garageTable->setHorizontalHeaderLabels({"ID", "Marque", "Modèle"});
 
-    auto voituresGarage = garage->getAllVoitures(); // Assure-toi que cette méthode existe
+    std::vector<PoigneeProduit> voituresGarage = garage->getAllVoitures();
     garageTable->setRowCount(static_cast<int>(voituresGarage.size()));
 
     for (size_t row = 0; row < voituresGarage.size(); ++row) {
-        auto voiture = voituresGarage[row];
+        const Voiture* voiture = commeVoiture(TableProduits::getInstance().obtenir(voituresGarage[row]));
+        if (voiture == nullptr) {
+            continue;
+        }
         garageTable->setItem(static_cast<int>(row), 0, new QTableWidgetItem(QString::number(voiture->getId())));
         garageTable->setItem(static_cast<int>(row), 1, new QTableWidgetItem(QString::fromStdString(voiture->getBrand())));
         garageTable->setItem(static_cast<int>(row), 2, new QTableWidgetItem(QString::fromStdString(voiture->getModel())));
@@ -86,15 +92,17 @@ void Vente::afficherGarageDialog() {
         }
 
         int row = garageTable->currentRow();
-        auto voiture = voituresGarage[row];
+        const Voiture* voiture = commeVoiture(TableProduits::getInstance().obtenir(voituresGarage[row]));
 
         bool ok;
         double prixDeVente = QInputDialog::getDouble(this, "Prix de vente", "Entrez le prix :", 0, 0, 1e6, 2, &ok);
 
         if (ok) {
-            voituresEnVente.push_back(voiture);
+            // La vente garde sa propre poignée, celle du garage est libérée en retirant la voiture
+            int id = voiture->getId();
+            voituresEnVente.push_back(TableProduits::getInstance().enregistrer(TableProduits::getInstance().partager(voituresGarage[row])));
             // Retirer la voiture du garage après l'avoir vendue
-            garage->removeVoiture(voiture->getId());
+            garage->removeVoiture(id);
             displayVoituresVente();
             garage->displayVoitures();
             QMessageBox::information(this, "Succès", "Voiture ajoutée en vente.");
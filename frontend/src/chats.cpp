@@ -76,6 +76,9 @@ void Chats::createChatTabs()
 
         for (size_t boiteIndex = 0; boiteIndex < acheteurBoites.size(); ++boiteIndex) {
             const auto &boite = acheteurBoites[boiteIndex];
+            if (boite->estVide()) {
+                continue; // Vendeur non contacte, absent du repertoire pour cette recherche
+            }
 
             QScrollArea *scrollArea = new QScrollArea();
             scrollArea->setWidgetResizable(true);
@@ -103,19 +106,20 @@ void Chats::createChatTabs()
 
             containerLayout->addLayout(buttonLayout);
 
-            for (size_t messageIndex = 0; messageIndex < boite->getBoiteAuLettres().size(); ++messageIndex) {
-                const auto &message = boite->getMessage(messageIndex);
+            const std::vector<Message> messages = boite->getBoiteAuLettres();
+            for (size_t messageIndex = 0; messageIndex < messages.size(); ++messageIndex) {
+                const Message message = messages[messageIndex];
 
                 QWidget *messageWidget = new QWidget(containerWidget);
                 QVBoxLayout *messageLayout = new QVBoxLayout(messageWidget);
                 messageLayout->setAlignment(messageIndex % 2 == 0 ? Qt::AlignLeft : Qt::AlignRight);
 
                 QPushButton *offerButton;
-                if (message->getObjet() == "search") {
+                if (message.getObjet() == Verbe::SEARCH) {
                     offerButton = new QPushButton("Search", messageWidget);
-                } else if (message->getObjet() == "offer") {
-                    offerButton = new QPushButton(QString("Offer: $%1").arg(message->getOffre()), messageWidget);
-                } else if (message->getObjet() == "break-down") {
+                } else if (message.getObjet() == Verbe::OFFER) {
+                    offerButton = new QPushButton(QString("Offer: $%1").arg(message.getOffre()), messageWidget);
+                } else if (message.getObjet() == Verbe::BREAK_DOWN) {
                     offerButton = new QPushButton("Break-down", messageWidget);
                 } else {
                     offerButton = new QPushButton("Accept", messageWidget);
@@ -153,15 +157,15 @@ void Chats::createChatTabs()
  * @brief Affiche les détails d'un message dans une boîte de dialogue.
  * @param message Le message dont les détails doivent être affichés.
  */
-void Chats::showDetails(std::shared_ptr<Message> message)
+void Chats::showDetails(const Message& message)
 {
     QDialog *detailsDialog = new QDialog(this);
     QVBoxLayout *detailsLayout = new QVBoxLayout(detailsDialog);
 
-    detailsLayout->addWidget(new QLabel(QString("Sender ID: %1").arg(message->getIdEmmeteur())));
-    detailsLayout->addWidget(new QLabel(QString("Receiver ID: %1").arg(message->getIdRecep())));
+    detailsLayout->addWidget(new QLabel(QString("Sender ID: %1").arg(message.getIdEmmeteur())));
+    detailsLayout->addWidget(new QLabel(QString("Receiver ID: %1").arg(message.getIdRecep())));
 
-    if (auto voiture = std::dynamic_pointer_cast<Voiture>(message->getProduit())) {
+    if (auto voiture = commeVoiture(message.getProduit())) {
         detailsLayout->addWidget(new QLabel(QString("Product (Car)")));
         detailsLayout->addWidget(new QLabel(QString("Brand: %1").arg(QString::fromStdString(voiture->getBrand()))));
         detailsLayout->addWidget(new QLabel(QString("Model: %1").arg(QString::fromStdString(voiture->getModel()))));
@@ -197,6 +201,14 @@ void Chats::showProtocol(std::shared_ptr<Protocol> prot)
     }else{
         protocolLayout->addWidget(new QLabel(QString("Produit achete peut differer: False")));
     }
+    if(prot->isAcheteursSimultanes()){
+        protocolLayout->addWidget(new QLabel(QString("Acheteurs simultanes: True")));
+    }else{
+        protocolLayout->addWidget(new QLabel(QString("Acheteurs simultanes: False")));
+    }
+    protocolLayout->addWidget(new QLabel(QString("Offres suffisantes a une recherche: %1").arg(prot->getOffresSuffisantes())));
+    protocolLayout->addWidget(new QLabel(QString("Delai de recherche (ms): %1").arg(prot->getDelaiRecherche())));
+    protocolLayout->addWidget(new QLabel(QString("Negociations par vendeur en meme temps: %1").arg(prot->getCapaciteVendeur())));
 
     protocolDialog->setWindowTitle("Protocol");
     protocolDialog->setModal(true);
@@ -48,7 +48,8 @@ Garage::Garage(QWidget* parent)
  * @brief Ajoute une liste de voitures au garage.
  *
  * Cette méthode permet d'ajouter un certain nombre de voitures à la liste interne du garage.
- * Les voitures sont ajoutées à la fin du vecteur `voitures`.
+ * Chaque voiture est enregistrée dans TableProduits sous une poignée propre au garage, ajoutée à la fin du
+ * vecteur `voitures` : elle reste au garage quand les produits de son ancien vendeur sont libérés.
  *
  * @param vo Un vecteur de pointeurs intelligents vers des objets `Voiture` à ajouter au garage.
  */
@@ -56,7 +57,7 @@ void Garage::ajouterVoiture(std::vector<std::shared_ptr<Voiture>> vo) {
 
     // Ajout de chaque voiture du vecteur à la liste interne du garage
     for (int var = 0; var < vo.size(); ++var) {
-        voitures.push_back(vo[var]);
+        voitures.push_back(TableProduits::getInstance().enregistrer(vo[var]));
     }
 
 }
@@ -76,7 +77,10 @@ void Garage::displayVoitures() {
 
     // Parcours des voitures et remplissage des cellules de la table
     for (size_t x = 0; x < voitures.size(); ++x) {
-        std::shared_ptr<Voiture> v = voitures[x];
+        const Voiture* v = commeVoiture(TableProduits::getInstance().obtenir(voitures[x]));
+        if (v == nullptr) {
+            continue;
+        }
 
         // Remplissage des colonnes de la table avec les attributs de chaque voiture
         tableWidget->setItem(static_cast<int>(x), 0, new QTableWidgetItem(QString::number(v->getId())));
@@ -94,17 +98,21 @@ void Garage::displayVoitures() {
     }
 }
 
-std::vector<std::shared_ptr<Voiture>> Garage::getAllVoitures() const {
+const std::vector<PoigneeProduit>& Garage::getAllVoitures() const {
     return voitures;
 }
 
 void Garage::removeVoiture(int id) {
-    auto it = std::remove_if(voitures.begin(), voitures.end(), [id](const std::shared_ptr<Voiture>& v) {
-        return v->getId() == id;  // Comparaison avec l'ID
+    auto it = std::remove_if(voitures.begin(), voitures.end(), [id](PoigneeProduit v) {
+        const Produit* p = TableProduits::getInstance().obtenir(v);
+        return p != nullptr && p->getId() == id;  // Comparaison avec l'ID
     });
 
     if (it != voitures.end()) {
-        // Suppression de la voiture
+        // Suppression de la voiture, sa poignée est libérée
+        for (auto r = it; r != voitures.end(); ++r) {
+            TableProduits::getInstance().liberer(*r);
+        }
         voitures.erase(it, voitures.end());
         qDebug() << "Voiture supprimée avec ID:" << id;
     } else {
@@ -157,9 +157,9 @@ void Store::addToCart(const Produits_dispos &product)
 {
     // Copie du produit pour modification
     Produits_dispos selectedProduct = product;
-    Voiture voit=Voiture();
-    voit.setBrand(selectedProduct.marque);
-    voit.setModel(selectedProduct.modele);
+    shared_ptr<Voiture> voit=make_shared<Voiture>();
+    voit->setBrand(selectedProduct.marque);
+    voit->setModel(selectedProduct.modele);
 
     // Affiche une boîte de dialogue pour entrer le prix souhaité
     bool ok;
@@ -172,8 +172,8 @@ void Store::addToCart(const Produits_dispos &product)
                                                   selectedProduct.prix_min, 0, 1000000, 2, &ok);
 
     if (ok) {
-        voit.setPrix(static_cast<float>(desiredPrice)); // Mise à jour avec le prix choisi
-        cart.push_back({voit, 0});  // Ajout au panier
+        voit->setPrix(static_cast<float>(desiredPrice)); // Mise à jour avec le prix choisi
+        cart.push_back({TableProduits::getInstance().enregistrer(voit), 0});  // Ajout au panier
 
 
 
@@ -191,7 +191,8 @@ void Store::addToCart(const Produits_dispos &product)
 
 void Store::ajouterProduit(){
     // Copie du produit pour modification
-    Voiture voit=Voiture();
+    shared_ptr<Voiture> voiture=make_shared<Voiture>();
+    Voiture& voit=*voiture;
     // Boîte de dialogue pour le prix souhaité
     bool ok;
     double desiredPrice = QInputDialog::getDouble(this, "Input Value", "Enter a value:",
@@ -220,7 +221,7 @@ void Store::ajouterProduit(){
         voit.setEssence(essence);
         voit.setMPG(mpg);
         voit.setTailleEngin(taille_e);
-        cart.push_back({voit, 0});  // Ajout au panier
+        cart.push_back({TableProduits::getInstance().enregistrer(voiture), 0});  // Ajout au panier
 
         QMessageBox::information(this,"Product Added", QString("Marque: %1, Modèle: %2, Year: %3, BoitedeVitesse: %4, Kilometres: %5, Essence: %6, MPG: %7, Engin: %8\n")
                                                             .arg(QString::fromStdString(voit.getBrand()))
@@ -250,24 +251,28 @@ void Store::viewCart()
 
 
     // Vector to store product details (Product, Strategy)
-    std::vector<std::tuple<Voiture, int>> productDetails;
+    std::vector<std::tuple<PoigneeProduit, int>> productDetails;
 
     QString cartDetails;
     double totalPrice = 0;
 
     // Collecte les détails pour chaque produit dans le panier
     for (const auto &product : cart) {
+        const Voiture* voit = commeVoiture(TableProduits::getInstance().obtenir(std::get<0>(product)));
+        if (voit == nullptr) {
+            continue;
+        }
 
         // Ajoute les détails du produit au résumé du panier
         cartDetails += QString("Marque: %1, Modèle: %2, Year: %3, BoitedeVitesse: %4, Kilometres: %5, Essence: %6, MPG: %7, Engin: %8\n")
-                           .arg(QString::fromStdString(std::get<0>(product).getBrand()))
-                           .arg(QString::fromStdString(std::get<0>(product).getModel()))
-                           .arg(std::get<0>(product).getYear())
-                           .arg(QString::fromStdString(std::get<0>(product).getBoiteDeVitesse()))
-                           .arg(std::get<0>(product).getKilometres())
-                           .arg(QString::fromStdString(std::get<0>(product).getEssence()))
-                           .arg(std::get<0>(product).getMPG())
-                           .arg(std::get<0>(product).getTailleEngin());
+                           .arg(QString::fromStdString(voit->getBrand()))
+                           .arg(QString::fromStdString(voit->getModel()))
+                           .arg(voit->getYear())
+                           .arg(QString::fromStdString(voit->getBoiteDeVitesse()))
+                           .arg(voit->getKilometres())
+                           .arg(QString::fromStdString(voit->getEssence()))
+                           .arg(voit->getMPG())
+                           .arg(voit->getTailleEngin());
 
 
 
@@ -278,8 +283,8 @@ void Store::viewCart()
         QVBoxLayout *layout = new QVBoxLayout(&strategyDialog);
         QLabel *infoLabel = new QLabel(
             QString("Veuillez sélectionner une stratégie pour le produit:\nMarque: %1, Modèle: %2")
-                .arg(QString::fromStdString(std::get<0>(product).getBrand()))
-                .arg(QString::fromStdString(std::get<0>(product).getModel()))
+                .arg(QString::fromStdString(voit->getBrand()))
+                .arg(QString::fromStdString(voit->getModel()))
             );
         layout->addWidget(infoLabel);
 
@@ -311,20 +316,20 @@ void Store::viewCart()
         productDetails.emplace_back(std::get<0>(product), selectedStrategyIndex);
 
         // Calculate total price
-        totalPrice +=std::get<0>(product).getPrix();
+        totalPrice +=voit->getPrix();
 
     }
 
     // Prépare et affiche le résumé du panier
     QString summary = "Résumé du Panier :\n\n" + cartDetails + "\n";
     for (const auto &detail : productDetails) {
-        const auto &produit = std::get<0>(detail);
+        const Voiture* voit = commeVoiture(TableProduits::getInstance().obtenir(std::get<0>(detail)));
         int strategyIndex = std::get<1>(detail);
 
         summary += QString("Marque: %1, Modèle: %2, Prix: $%3, Stratégie: %4\n")
-                       .arg(QString::fromStdString(produit.getBrand()))
-                       .arg(QString::fromStdString(produit.getModel()))
-                       .arg(produit.getPrix())
+                       .arg(QString::fromStdString(voit->getBrand()))
+                       .arg(QString::fromStdString(voit->getModel()))
+                       .arg(voit->getPrix())
                        .arg(strategyIndex); // Display strategy as 1-based index
 
     }
@@ -335,7 +340,7 @@ void Store::viewCart()
     // Émet le signal avec les détails du panier validé
     emit cartValidated(productDetails);
 
-    // Vide le panier après validation
+    // Vide le panier après validation, les voitures recherchées sont libérées par MainWindow après la négociation
     cart.clear();
 }
 
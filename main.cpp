@@ -9,22 +9,63 @@
 
 #include "back_end_main.h"
 #include "MainWindow.h"
+#include "Catalogue.h"
+#include "GenerateurAleatoire.h"
+#include "Negociation.h"
 #include <QApplication>
+#include <string>
+#include <cstdlib>
+#include <cctype>
 
 /**
  * @brief Fonction principale du programme.
  *
- * Cette fonction initialise l'application Qt, crée la fenêtre principale de l'application et la montre à l'utilisateur.
- * Ensuite, elle entre dans la boucle d'exécution de l'application en appelant `app.exec()`.
+ * Cette fonction initialise l'application Qt, lance le chargement du catalogue en arrière-plan, crée la fenêtre
+ * principale de l'application et la montre à l'utilisateur. Ensuite, elle entre dans la boucle d'exécution de
+ * l'application en appelant `app.exec()`.
+ *
+ * Options : `--graine N` fixe la graine de session (exécution reproductible), `--sans-interface [N]` lance une
+ * session de négociation avec N acheteurs (3 par défaut) dans la console, sans ouvrir de fenêtre, et
+ * `--simultanes` y fait négocier tous les acheteurs en même temps au lieu de l'un après l'autre ; `--capacite N`
+ * permet à chaque vendeur de mener N négociations en même temps (1 par défaut). `--threads` donne un thread à
+ * chaque agent au lieu de reprendre les coroutines dans le pool, pour comparer les deux exécutions.
  *
  * @param argc Nombre d'arguments passés en ligne de commande.
  * @param argv Tableau des arguments passés en ligne de commande.
  * @return Le code de sortie de l'application.
  */
 int main(int argc, char *argv[]) {
+    bool sans_interface = false;
+    bool simultanes = false;
+    int capacite = 1;
+    int nbr_acheteurs = 3;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--graine" && i + 1 < argc) {
+            GenerateurAleatoire::setGraineSession(std::strtoull(argv[++i], nullptr, 10));
+        } else if (option == "--sans-interface") {
+            sans_interface = true;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                nbr_acheteurs = std::atoi(argv[++i]);
+            }
+        } else if (option == "--simultanes") {
+            simultanes = true;
+        } else if (option == "--capacite" && i + 1 < argc) {
+            capacite = std::atoi(argv[++i]);
+        } else if (option == "--threads") {
+            Negociation::setExecution(Negociation::Execution::THREADS);
+        }
+    }
+    if (sans_interface) {
+        return lancer_sans_interface(nbr_acheteurs, simultanes, capacite);
+    }
+
     // Initialisation de l'application Qt
     QApplication app(argc, argv);
 
+    // Chargement du catalogue pendant l'affichage de l'écran de démarrage
+    Catalogue::getInstance().precharger();
+
     // Création de la fenêtre principale
     MainWindow mainWindow;
 
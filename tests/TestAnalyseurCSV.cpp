@@ -0,0 +1,128 @@
+/**
+ * @file TestAnalyseurCSV.cpp
+ * @brief Équivalence de l'analyseur CSV avec et sans SSE2/AVX2.
+ *
+ * Chaque contenu est analysé deux fois, avec la version choisie selon le processeur puis avec la boucle simple
+ * forcée : les lignes lues et les positions doivent être identiques. Les fichiers de data/ sont complétés par des
+ * cas limites (fin de contenu sans '\n', lignes de plus de 64 octets, champ manquant, en-tête "tax(£)").
+ */
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include "Verification.h"
+#include "AnalyseurCSV.h"
+
+using namespace std;
+
+namespace {
+
+struct Analyse {
+    bool en_tete = false;
+    vector<LigneCSV> lignes;
+    vector<size_t> positions;
+};
+
+Analyse analyser(string_view contenu, bool scalaire) {
+    AnalyseurCSV::forcerScalaire(scalaire);
+    Analyse resultat;
+    AnalyseurCSV analyseur(contenu);
+    resultat.en_tete = analyseur.lireEnTete();
+    LigneCSV ligne;
+    while (resultat.en_tete && analyseur.suivante(ligne)) {
+        resultat.lignes.push_back(ligne);
+        resultat.positions.push_back(analyseur.getPosition());
+    }
+    AnalyseurCSV::forcerScalaire(false);
+    return resultat;
+}
+
+bool memeLigne(const LigneCSV& a, const LigneCSV& b) {
+    if (a.valide != b.valide) {
+        return false;
+    }
+    //Les champs d'une ligne invalide ne sont pas tous lus
+    return !a.valide || (a.modele == b.modele && a.annee == b.annee && a.prix == b.prix && a.boite == b.boite
+                         && a.kilometres == b.kilometres && a.essence == b.essence && a.taxe == b.taxe
+                         && a.mpg == b.mpg && a.taille_engin == b.taille_engin);
+}
+
+//Compare les deux versions sur un contenu, retourne l'analyse SIMD
+Analyse comparer(const string& nom, string_view contenu) {
+    Analyse simd = analyser(contenu, false);
+    Analyse scalaire = analyser(contenu, true);
+    bool identiques = simd.en_tete == scalaire.en_tete && simd.lignes.size() == scalaire.lignes.size()
+                      && simd.positions == scalaire.positions;
+    for (size_t i = 0; identiques && i < simd.lignes.size(); i++) {
+        identiques = memeLigne(simd.lignes[i], scalaire.lignes[i]);
+    }
+    if (!identiques) {
+        cerr << "analyses differentes: " << nom << endl;
+    }
+    VERIFIER(identiques);
+    return simd;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <dossier data>" << endl;
+        return 2;
+    }
+    cout << "Jeu d'instructions: " << AnalyseurCSV::getJeuInstructions() << endl;
+    AnalyseurCSV::forcerScalaire(true);
+    VERIFIER(string(AnalyseurCSV::getJeuInstructions()) == "scalaire");
+    AnalyseurCSV::forcerScalaire(false);
+
+    //Fichiers du catalogue
+    int nbr_fichiers = 0;
+    for (const auto& entree : filesystem::directory_iterator(argv[1])) {
+        if (entree.path().extension() != ".csv") {
+            continue;
+        }
+        ifstream fichier(entree.path(), ios::binary);
+        stringstream tampon;
+        tampon << fichier.rdbuf();
+        string contenu = tampon.str();
+        Analyse a = comparer(entree.path().filename().string(), contenu);
+        VERIFIER(a.en_tete);
+        VERIFIER(!a.lignes.empty());
+        nbr_fichiers++;
+    }
+    VERIFIER(nbr_fichiers > 0);
+
+    //Colonne avec unite, derniere ligne sans '\n'
+    string unite = "model,year,price,transmission,mileage,fuelType,tax(£),mpg,engineSize\n"
+                   " I20,2017,7999,Manual,17307,Petrol,145,58.9,1.2\n"
+                   " Tucson,2016,14499,Automatic,25233,Diesel,235,43.5,2.0";
+    Analyse a = comparer("tax(£)", unite);
+    VERIFIER(a.lignes.size() == 2);
+    VERIFIER(a.lignes.size() == 2 && a.lignes[0].valide && a.lignes[0].taxe == 145 && a.lignes[0].modele == " I20");
+    VERIFIER(a.lignes.size() == 2 && a.lignes[1].valide && a.lignes[1].prix == 14499.0f && a.lignes[1].taille_engin == 2.0f);
+
+    //Colonnes dans un autre ordre, ligne de plus de 64 octets, champ manquant, champ non numerique
+    string desordre = "price,model,year,mileage,transmission,fuelType,tax,engineSize,mpg\n"
+                      "12000, Un modele dont le nom depasse largement un bloc de soixante-quatre octets,2019,"
+                      "100,Manual,Petrol,150,1.4,55.4\n"
+                      "9000, Court,2018,2000,Manual,Diesel,30\n"
+                      "abc, Faux,2018,2000,Manual,Diesel,30,1.0,60.1\n"
+                      "8000, Dernier,2015,50000,Automatic,Hybrid,0,1.8,70.6\n";
+    a = comparer("desordre", desordre);
+    VERIFIER(a.lignes.size() == 4);
+    VERIFIER(a.lignes.size() == 4 && a.lignes[0].valide && a.lignes[0].annee == 2019 && a.lignes[0].mpg == 55.4f);
+    VERIFIER(a.lignes.size() == 4 && !a.lignes[1].valide && !a.lignes[2].valide);
+    VERIFIER(a.lignes.size() == 4 && a.lignes[3].valide && a.lignes[3].essence == "Hybrid");
+
+    //Toutes les longueurs de contenu autour d'un et deux blocs
+    string ligne = " A1,2017,12500,Manual,15735,Petrol,150,55.4,1.4\n";
+    string long_contenu = "model,year,price,transmission,mileage,fuelType,tax,mpg,engineSize\n";
+    for (int i = 0; i < 4; i++) {
+        long_contenu += ligne;
+    }
+    for (size_t taille = 0; taille <= long_contenu.size(); taille++) {
+        comparer("prefixe de " + to_string(taille) + " octets", string_view(long_contenu).substr(0, taille));
+    }
+
+    return resultat("TestAnalyseurCSV");
+}
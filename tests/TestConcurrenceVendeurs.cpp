@@ -0,0 +1,240 @@
+/**
+ * @file TestConcurrenceVendeurs.cpp
+ * @brief Règles d'un vendeur qui négocie avec plusieurs acheteurs en même temps.
+ *
+ * D'abord un vendeur seul, dont la coroutine est menée lettre par lettre : une fois à capacite_vendeur
+ * discussions, il refuse (break-down) la recherche suivante ; une voiture déjà en négociation avec un acheteur
+ * est refusée aux autres ; une voiture vendue quitte l'inventaire et n'est plus proposée. Ensuite des sessions
+ * sans interface, acheteurs simultanés et capacité > 1, où les acheteurs visent peu de modèles : aucune voiture
+ * n'est vendue deux fois, et chaque inventaire perd exactement les voitures achetées chez ce vendeur.
+ */
+
+#include <set>
+#include <map>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "Verification.h"
+#include "back_end_main.h"
+#include "Catalogue.h"
+#include "GenerateurAleatoire.h"
+#include "TableProduits.h"
+#include "Negociation.h"
+#include "Threads_var.h"
+
+using namespace std;
+
+namespace {
+
+const int NBR_ACHETEURS = 3;
+
+//Attente d'un reveil, au plus 5 s pour ne pas bloquer ctest si le vendeur ne repond pas
+bool attendre(const function<bool()>& pret) {
+    for (int i = 0; i < 5000 && !pret(); i++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return pret();
+}
+
+PoigneeProduit recherche(const string& marque, const string& modele) {
+    shared_ptr<Voiture> voiture = make_shared<Voiture>();
+    voiture->setBrand(marque);
+    voiture->setModel(modele);
+    return TableProduits::getInstance().enregistrer(voiture);
+}
+
+//Lettre d'un acheteur au vendeur 0, comme Acheteur::negocier : une recherche ouvre d'abord la collecte
+void envoyer(Vendeur& vendeur, int acheteur, Verbe objet, PoigneeProduit prod) {
+    if (objet == Verbe::SEARCH) {
+        collectes_Achet[acheteur]->ouvrir(1, 0, evenements_Achet[acheteur].get());
+    }
+    vendeur.getBoiteAuLettres(acheteur)->laisserMessage(Message(acheteur, 0, objet, 0, prod),
+                                                          BoiteAuLettres::Emetteur::ACHETEUR);
+    evenements_Vend[0]->signaler();
+}
+
+//Objet de la derniere lettre de la boite une fois l'acheteur reveille, AUCUN si le vendeur ne l'a pas reveille
+Verbe reponse(Vendeur& vendeur, int acheteur) {
+    Evenement& reveil = *evenements_Achet[acheteur];
+    if (!attendre([&reveil] { return reveil.estPret(); })) {
+        return Verbe::AUCUN;
+    }
+    reveil.consommer();
+    return vendeur.getBoiteAuLettres(acheteur)->dernierMessage().getObjet();
+}
+
+bool enInventaire(const Vendeur& vendeur, int id) {
+    for (const shared_ptr<Produit>& p : vendeur.getProduits()) {
+        if (p->getId() == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Un vendeur avec une Audi A3 et une BMW X1, trois acheteurs joues par le test
+void vendeurSeul(int capacite) {
+    init_shared_resources_Acheteur(NBR_ACHETEURS);
+    init_shared_resources_Vendeur(1);
+    shared_ptr<Protocol> protocole = make_shared<Protocol>();
+    protocole->setNbrTours(5);
+    protocole->setPenalite(5);
+    protocole->setCapaciteVendeur(capacite);
+
+    Vendeur vendeur(0, NBR_ACHETEURS);
+    vendeur.setStyle_negociacion(1);
+    vendeur.set_tKarma(100);
+    int id_a3 = Produit::nouvelIdentifiant();
+    int id_x1 = Produit::nouvelIdentifiant();
+    vendeur.addVoiture(id_a3, "", 20000, "Voiture", "", "Audi", "A3", 2018, "Manual", 30000, "Petrol", 50, 1.6f);
+    vendeur.addVoiture(id_x1, "", 30000, "Voiture", "", "BMW", "X1", 2019, "Automatic", 20000, "Diesel", 45, 2.0f);
+    for (int i = 0; i < NBR_ACHETEURS; i++) {
+        vendeur.insertBaL(i, make_shared<BoiteAuLettres>(protocole));
+    }
+    PoigneeProduit a3 = recherche("Audi", "A3");
+    PoigneeProduit x1 = recherche("BMW", "X1");
+
+    atomic<bool> fini = false;
+    {
+        Negociation negociation = vendeur.negocier(0);
+        negociation.demarrer([&fini] { fini = true; });
+
+        envoyer(vendeur, 0, Verbe::SEARCH, a3);
+        VERIFIER(reponse(vendeur, 0) == Verbe::OFFER);
+
+        if (capacite == 1) {
+            //Vendeur occupe : la recherche d'une autre voiture est refusee, puis acceptee une fois la place libre
+            envoyer(vendeur, 1, Verbe::SEARCH, x1);
+            VERIFIER(reponse(vendeur, 1) == Verbe::BREAK_DOWN);
+            envoyer(vendeur, 1, Verbe::BREAK_DOWN, x1);
+            envoyer(vendeur, 0, Verbe::ACCEPT, a3);
+            VERIFIER(reponse(vendeur, 0) == Verbe::ACCEPT);
+            envoyer(vendeur, 1, Verbe::SEARCH, x1);
+            VERIFIER(reponse(vendeur, 1) == Verbe::OFFER);
+        } else {
+            //Place libre, mais l'A3 est en negociation avec l'acheteur 0
+            envoyer(vendeur, 1, Verbe::SEARCH, a3);
+            VERIFIER(reponse(vendeur, 1) == Verbe::BREAK_DOWN);
+            envoyer(vendeur, 1, Verbe::BREAK_DOWN, a3);
+            envoyer(vendeur, 2, Verbe::SEARCH, x1);
+            VERIFIER(reponse(vendeur, 2) == Verbe::OFFER);
+            //Vendue a l'accord : l'A3 n'est plus proposee
+            envoyer(vendeur, 0, Verbe::ACCEPT, a3);
+            VERIFIER(reponse(vendeur, 0) == Verbe::ACCEPT);
+            envoyer(vendeur, 1, Verbe::SEARCH, a3);
+            VERIFIER(reponse(vendeur, 1) == Verbe::BREAK_DOWN);
+        }
+        VERIFIER(vendeur.getProduits().size() == 1);
+        VERIFIER(!enInventaire(vendeur, id_a3));
+        VERIFIER(enInventaire(vendeur, id_x1));
+
+        termination_flag->store(true);
+        evenements_Vend[0]->signaler();
+        VERIFIER(attendre([&fini] { return fini.load(); }));
+    }
+
+    TableProduits::getInstance().liberer(a3);
+    TableProduits::getInstance().liberer(x1);
+    vendeur.libererProduits();
+}
+
+//Session avec acheteurs simultanes ; rend le nombre d'achats
+size_t sessionSimultanee(uint64_t graine, int nbr_acheteurs, int capacite) {
+    GenerateurAleatoire::setGraineSession(graine);
+    vector<vector<int>> param_vendeurs = {{1, 8, 3}, {2, 8, 4}, {3, 8, 4}, {5, 8, 4}};
+    vector<Vendeur> vendeurs;
+    vendeur_Initialisation(vendeurs, param_vendeurs);
+    map<int, int> vendeur_de;   //Identifiant d'annonce -> vendeur
+    vector<size_t> tailles;
+    for (size_t v = 0; v < vendeurs.size(); v++) {
+        tailles.push_back(vendeurs[v].getProduits().size());
+        for (const shared_ptr<Produit>& p : vendeurs[v].getProduits()) {
+            vendeur_de[p->getId()] = v;
+        }
+    }
+    vector<Produits_dispos> p_d;
+    recuperer_tous_produits(p_d, vendeurs);
+
+    shared_ptr<Protocol> protocole = make_shared<Protocol>();
+    protocole->setNbrTours(5);
+    protocole->setNbrOblAchet(4);
+    protocole->setPenalite(5);
+    protocole->setNegMemeTemps(3);
+    protocole->setAcheteursSimultanes(true);
+    protocole->setCapaciteVendeur(capacite);
+
+    int nbr_vendeurs = vendeurs.size();
+    vector<Acheteur> acheteurs;
+    acheteur_Initialisation(acheteurs, nbr_acheteurs, nbr_vendeurs);
+    bal_Initialisation(nbr_vendeurs, nbr_acheteurs, vendeurs, acheteurs, protocole);
+
+    //Tous les acheteurs visent les memes quelques modeles, pour qu'ils se disputent les voitures
+    GenerateurAleatoire aleatoire = GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_SANS_INTERFACE, 0);
+    int nbr_modeles = min<int>(p_d.size(), 3);
+    vector<PoigneeProduit> recherches;
+    for (int i = 0; i < nbr_acheteurs && nbr_modeles > 0; i++) {
+        const Produits_dispos& choix = p_d[aleatoire.entre(0, nbr_modeles - 1)];
+        shared_ptr<Voiture> voiture = make_shared<Voiture>();
+        voiture->setBrand(choix.marque);
+        voiture->setModel(choix.modele);
+        voiture->setPrix(choix.prix_max * 2);
+        acheteurs[i].setStrat(aleatoire.entre(1, 5));
+        recherches.push_back(TableProduits::getInstance().enregistrer(voiture));
+        acheteurs[i].setProd(recherches.back());
+    }
+
+    vector<shared_ptr<Voiture>> achats;
+    start_negocier(acheteurs, vendeurs, achats);
+
+    set<int> vendus;
+    vector<size_t> vendus_par_vendeur(vendeurs.size(), 0);
+    for (const shared_ptr<Voiture>& v : achats) {
+        VERIFIER(vendus.insert(v->getId()).second);
+        VERIFIER(vendeur_de.count(v->getId()) == 1);
+        if (vendeur_de.count(v->getId()) == 1) {
+            vendus_par_vendeur[vendeur_de[v->getId()]]++;
+        }
+    }
+    for (size_t v = 0; v < vendeurs.size(); v++) {
+        VERIFIER(vendeurs[v].getProduits().size() + vendus_par_vendeur[v] == tailles[v]);
+        for (const shared_ptr<Produit>& p : vendeurs[v].getProduits()) {
+            VERIFIER(vendus.count(p->getId()) == 0);
+            VERIFIER(vendeur_de.count(p->getId()) == 1 && vendeur_de[p->getId()] == static_cast<int>(v));
+        }
+    }
+
+    for (PoigneeProduit r : recherches) {
+        TableProduits::getInstance().liberer(r);
+    }
+    for (Vendeur& v : vendeurs) {
+        v.libererProduits();
+    }
+    return achats.size();
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || !Catalogue::getInstance().charger(copierDonnees(argv[1], "TestConcurrenceVendeurs"))) {
+        cerr << "catalogue introuvable" << endl;
+        return 1;
+    }
+
+    for (Negociation::Execution execution : {Negociation::Execution::ORDONNANCEUR, Negociation::Execution::THREADS}) {
+        Negociation::setExecution(execution);
+        vendeurSeul(1);
+        vendeurSeul(2);
+
+        size_t nbr_achats = 0;
+        for (uint64_t graine : {1, 7, 42}) {
+            for (int capacite : {2, 3}) {
+                nbr_achats += sessionSimultanee(graine, 12, capacite);
+            }
+        }
+        //Sans achat, les verifications de la session ne prouveraient rien
+        VERIFIER(nbr_achats > 0);
+    }
+    Negociation::setExecution(Negociation::Execution::ORDONNANCEUR);
+
+    return resultat("TestConcurrenceVendeurs");
+}
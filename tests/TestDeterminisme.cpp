@@ -0,0 +1,133 @@
+/**
+ * @file TestDeterminisme.cpp
+ * @brief Reproductibilité d'une session avec la même graine.
+ *
+ * Les flux de GenerateurAleatoire doivent redonner les mêmes tirages pour la même graine. Une session sans
+ * interface, acheteurs l'un après l'autre comme dans lancer_sans_interface, est ensuite jouée deux fois avec la
+ * même graine : inventaires, choix des acheteurs et achats doivent être identiques. Les identifiants d'annonce
+ * ne sont pas comparés, ils continuent d'augmenter d'une session à l'autre. La session rejouée avec un thread par
+ * agent (Negociation::Execution::THREADS) doit aussi donner les mêmes achats.
+ */
+
+#include <sstream>
+#include "Verification.h"
+#include "back_end_main.h"
+#include "Catalogue.h"
+#include "GenerateurAleatoire.h"
+#include "TableProduits.h"
+#include "Negociation.h"
+
+using namespace std;
+
+namespace {
+
+vector<uint64_t> tirages(GenerateurAleatoire g, int nbr) {
+    vector<uint64_t> resultat;
+    for (int i = 0; i < nbr; i++) {
+        resultat.push_back(g.suivant());
+    }
+    return resultat;
+}
+
+//Joue une session et la resume en texte
+string session(uint64_t graine, int nbr_acheteurs) {
+    GenerateurAleatoire::setGraineSession(graine);
+    ostringstream resume;
+
+    vector<vector<int>> param_vendeurs = {{1, 10, 3}, {2, 34, 4}, {1, 123, 4}, {2, 234, 4}, {1, 1, 4}};
+    vector<Vendeur> vendeurs;
+    vendeur_Initialisation(vendeurs, param_vendeurs);
+    for (const Vendeur& v : vendeurs) {
+        for (const shared_ptr<Produit>& p : v.getProduits()) {
+            const Voiture* voiture = commeVoiture(p.get());
+            resume << voiture->getBrand() << voiture->getModel() << " " << voiture->getPrix() << "\n";
+        }
+    }
+    vector<Produits_dispos> p_d;
+    recuperer_tous_produits(p_d, vendeurs);
+
+    shared_ptr<Protocol> protocole = make_shared<Protocol>();
+    protocole->setNbrTours(5);
+    protocole->setNbrOblAchet(4);
+    protocole->setPenalite(5);
+    protocole->setNegMemeTemps(3);
+
+    int nbr_vendeurs = vendeurs.size();
+    vector<Acheteur> acheteurs;
+    acheteur_Initialisation(acheteurs, nbr_acheteurs, nbr_vendeurs);
+    bal_Initialisation(nbr_vendeurs, nbr_acheteurs, vendeurs, acheteurs, protocole);
+
+    GenerateurAleatoire aleatoire = GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_SANS_INTERFACE, 0);
+    vector<PoigneeProduit> recherches;
+    for (int i = 0; i < nbr_acheteurs; i++) {
+        const Produits_dispos& choix = p_d[aleatoire.entre(0, p_d.size() - 1)];
+        shared_ptr<Voiture> voiture = make_shared<Voiture>();
+        voiture->setBrand(choix.marque);
+        voiture->setModel(choix.modele);
+        voiture->setPrix(aleatoire.entre(choix.prix_min, choix.prix_max));
+        acheteurs[i].setStrat(aleatoire.entre(1, 5));
+        recherches.push_back(TableProduits::getInstance().enregistrer(voiture));
+        acheteurs[i].setProd(recherches.back());
+        resume << "acheteur " << i << ": " << choix.marque << choix.modele << " " << voiture->getPrix() << "\n";
+    }
+
+    vector<shared_ptr<Voiture>> achats;
+    start_negocier(acheteurs, vendeurs, achats);
+    for (const auto& v : achats) {
+        resume << "achat: " << v->getBrand() << v->getModel() << " " << v->getPrix() << "\n";
+    }
+
+    for (PoigneeProduit r : recherches) {
+        TableProduits::getInstance().liberer(r);
+    }
+    for (Vendeur& v : vendeurs) {
+        v.libererProduits();
+    }
+    return resume.str();
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <dossier data>" << endl;
+        return 2;
+    }
+
+    //Flux : meme graine, memes tirages ; familles et indices differents, flux differents
+    VERIFIER(tirages(GenerateurAleatoire(42), 100) == tirages(GenerateurAleatoire(42), 100));
+    VERIFIER(tirages(GenerateurAleatoire(42), 100) != tirages(GenerateurAleatoire(43), 100));
+    GenerateurAleatoire::setGraineSession(42);
+    VERIFIER(GenerateurAleatoire::getGraineSession() == 42);
+    auto vendeur0 = tirages(GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_VENDEUR, 0), 100);
+    VERIFIER(vendeur0 == tirages(GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_VENDEUR, 0), 100));
+    VERIFIER(vendeur0 != tirages(GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_VENDEUR, 1), 100));
+    VERIFIER(vendeur0 != tirages(GenerateurAleatoire::flux(GenerateurAleatoire::FLUX_ACHETEUR, 0), 100));
+    GenerateurAleatoire g(7);
+    bool bornes = true;
+    for (int i = 0; i < 10000; i++) {
+        int x = g.entre(-3, 5);
+        bornes = bornes && x >= -3 && x <= 5;
+    }
+    VERIFIER(bornes);
+
+    //Sessions completes
+    string dossier = copierDonnees(argv[1], "test_determinisme");
+    VERIFIER(Catalogue::getInstance().charger(dossier));
+    string premiere = session(42, 6);
+    string seconde = session(42, 6);
+    string autre = session(43, 6);
+    VERIFIER(!premiere.empty());
+    VERIFIER(premiere == seconde);
+    VERIFIER(premiere != autre);
+    if (premiere != seconde) {
+        cerr << "--- premiere session ---\n" << premiere << "--- seconde session ---\n" << seconde;
+    }
+    Negociation::setExecution(Negociation::Execution::THREADS);
+    string threads = session(42, 6);
+    Negociation::setExecution(Negociation::Execution::ORDONNANCEUR);
+    VERIFIER(premiere == threads);
+
+    filesystem::remove_all(dossier);
+    return resultat("TestDeterminisme");
+}
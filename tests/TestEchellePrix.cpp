@@ -0,0 +1,133 @@
+/**
+ * @file TestEchellePrix.cpp
+ * @brief Augmentations paresseuses des prix d'un vendeur (EchellePrix) comparées à l'augmentation produit par produit.
+ *
+ * Le prix de chaque voiture est suivi à part, augmenté un à un comme avant l'échelle. Après chaque pénalité
+ * (augmenterTousPrix), getPrix doit rendre ce prix, y compris pour les voitures dont le prix a été fixé après un
+ * changement du facteur. appliquerPrix reporte le facteur sans changer aucun prix, et la recherche du vendeur, qui
+ * s'arrête à la première voiture du seau, doit toujours rendre la moins chère. Une copie détachée de l'échelle
+ * (voiture achetée) garde son prix.
+ */
+
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "Verification.h"
+#include "Vendeur.h"
+#include "EchellePrix.h"
+#include "GenerateurAleatoire.h"
+#include "TableProduits.h"
+
+using namespace std;
+
+namespace {
+
+bool proche(double a, double b) {
+    return fabs(a - b) <= 1e-4 * max(fabs(a), fabs(b));
+}
+
+//Prix suivis produit par produit : identifiant d'annonce -> prix
+int ecartsPrix(const Vendeur& v, const map<int, double>& attendus) {
+    int ecarts = 0;
+    for (const shared_ptr<Produit>& p : v.getProduits()) {
+        auto it = attendus.find(p->getId());
+        ecarts += it == attendus.end() || !proche(p->getPrix(), it->second);
+    }
+    return ecarts + (v.getProduits().size() != attendus.size());
+}
+
+//La recherche rend une voiture du prix le plus bas parmi celles du modele
+bool rendLaMoinsChere(Vendeur& v, const Voiture& recherche) {
+    shared_ptr<Produit> trouve = v.chercherProduit(&recherche);
+    float plus_bas = -1;
+    for (const shared_ptr<Produit>& p : v.getProduits()) {
+        const Voiture* voiture = commeVoiture(p.get());
+        if (voiture->getModel() == recherche.getModel() && (plus_bas < 0 || p->getPrix() < plus_bas)) {
+            plus_bas = p->getPrix();
+        }
+    }
+    return plus_bas < 0 ? trouve == nullptr : trouve != nullptr && trouve->getPrix() == plus_bas;
+}
+
+}
+
+int main() {
+    EchellePrix echelle;
+    VERIFIER(echelle.getFacteur() == 1.0);
+    echelle.multiplier(1.05);
+    echelle.multiplier(1.10);
+    VERIFIER(proche(echelle.getFacteur(), 1.05 * 1.10));
+
+    GenerateurAleatoire g(17);
+    Vendeur v(0, 1);
+    map<int, double> attendus;
+    for (int i = 0; i < 60; i++) {
+        int id = Produit::nouvelIdentifiant();
+        float prix = g.entre(100, 300) * 100.0f;
+        v.addVoiture(id, "", prix, "Voiture", "", i % 3 ? "Audi" : "BMW", i % 3 ? "A3" : "X1", 2018, "Manual",
+                     30000, "Petrol", 50, 1.6f);
+        attendus[id] = prix;
+    }
+    Voiture a3;
+    a3.setBrand("Audi");
+    a3.setModel("A3");
+    Voiture x1;
+    x1.setBrand("BMW");
+    x1.setModel("X1");
+    VERIFIER(ecartsPrix(v, attendus) == 0);
+
+    shared_ptr<Voiture> achetee = nullptr;
+    float prix_achat = 0;
+    for (int etape = 0; etape < 30; etape++) {
+        int pourcentage = g.entre(1, 10);
+        v.augmenterTousPrix(pourcentage);
+        for (auto& [id, prix] : attendus) {
+            prix = static_cast<float>(prix * (1.0 + pourcentage / 100.0));
+        }
+        VERIFIER(ecartsPrix(v, attendus) == 0);
+
+        //Prix fixes apres un changement du facteur, assez bas pour passer en tete de leur seau
+        for (int i = 0; i < 3; i++) {
+            const shared_ptr<Produit>& p = v.getProduits()[g.entre(0, v.getProduits().size() - 1)];
+            float prix = g.entre(50, 300) * 100.0f;
+            p->setPrix(prix);
+            attendus[p->getId()] = prix;
+        }
+        VERIFIER(ecartsPrix(v, attendus) == 0);
+        VERIFIER(rendLaMoinsChere(v, a3));
+        VERIFIER(rendLaMoinsChere(v, x1));
+
+        //Reporter le facteur ne change aucun prix, ni les augmentations suivantes
+        if (etape % 4 == 3) {
+            vector<float> avant;
+            for (const shared_ptr<Produit>& p : v.getProduits()) {
+                avant.push_back(p->getPrix());
+            }
+            v.appliquerPrix();
+            int changes = 0;
+            for (size_t i = 0; i < avant.size(); i++) {
+                changes += v.getProduits()[i]->getPrix() != avant[i];
+            }
+            VERIFIER(changes == 0);
+        }
+
+        //Vente de la moins chere : la copie achetee ne suit plus l'echelle
+        if (etape == 10) {
+            shared_ptr<Produit> vendue = v.chercherProduit(&a3);
+            VERIFIER(vendue != nullptr);
+            if (vendue != nullptr) {
+                achetee = make_shared<Voiture>(*commeVoiture(vendue.get()));
+                achetee->setPoignee(PoigneeProduit());
+                achetee->figerPrix();
+                prix_achat = achetee->getPrix();
+                VERIFIER(proche(prix_achat, attendus[vendue->getId()]));
+                attendus.erase(vendue->getId());
+                VERIFIER(v.vendre(vendue.get()));
+            }
+        }
+    }
+    VERIFIER(achetee != nullptr && achetee->getPrix() == prix_achat);
+
+    v.libererProduits();
+    return resultat("TestEchellePrix");
+}
@@ -0,0 +1,183 @@
+/**
+ * @file TestFiltreLot.cpp
+ * @brief Équivalence du filtre par lot AVX2 avec la boucle simple, et du lot avec les recherches une à une.
+ *
+ * Des inventaires tirés au hasard, de toutes les tailles autour de 8 lignes et avec beaucoup de prix égaux,
+ * sont filtrés avec la version choisie selon le processeur puis avec la boucle simple forcée : les lignes
+ * retenues doivent être les mêmes, et celles d'un parcours de référence. Sur un vendeur du catalogue,
+ * Vendeur::chercherProduits doit ensuite donner le même prix que Vendeur::chercherProduit pour chaque recherche.
+ */
+
+#include <vector>
+#include "Verification.h"
+#include "FiltreLot.h"
+#include "GenerateurAleatoire.h"
+#include "Catalogue.h"
+#include "Vendeur.h"
+
+using namespace std;
+
+namespace {
+
+struct Colonnes {
+    vector<int32_t> annees, kilometres;
+    vector<float> mpgs, tailles_engin, prix;
+    vector<IdChaine> marques, modeles, boites, essences, categories;
+
+    InventaireColonnes vue() const {
+        InventaireColonnes inv;
+        inv.nbr_lignes = annees.size();
+        inv.annees = annees.data();
+        inv.kilometres = kilometres.data();
+        inv.mpgs = mpgs.data();
+        inv.tailles_engin = tailles_engin.data();
+        inv.prix = prix.data();
+        inv.marques = marques.data();
+        inv.modeles = modeles.data();
+        inv.boites = boites.data();
+        inv.essences = essences.data();
+        inv.categories = categories.data();
+        return inv;
+    }
+};
+
+//Peu de valeurs distinctes, pour que les recherches trouvent souvent et que les prix soient souvent egaux
+Colonnes inventaire(GenerateurAleatoire& g, size_t nbr_lignes) {
+    Colonnes c;
+    for (size_t l = 0; l < nbr_lignes; l++) {
+        c.annees.push_back(g.entre(2010, 2020));
+        c.kilometres.push_back(g.entre(0, 10) * 10000);
+        c.mpgs.push_back(g.entre(30, 60));
+        c.tailles_engin.push_back(g.entre(10, 30) / 10.0f);
+        c.prix.push_back(g.entre(10, 20) * 1000.0f);
+        c.marques.push_back(g.entre(1, 4));
+        c.modeles.push_back(g.entre(1, 8));
+        c.boites.push_back(g.entre(1, 2));
+        c.essences.push_back(g.entre(1, 3));
+        c.categories.push_back(1);
+    }
+    return c;
+}
+
+RequeteFiltre requete(GenerateurAleatoire& g) {
+    RequeteFiltre r;
+    if (g.entre(0, 1)) r.annee_min = g.entre(2010, 2020);
+    if (g.entre(0, 1)) r.kilometres_max = g.entre(0, 10) * 10000;
+    if (g.entre(0, 3) == 0) r.mpg_min = g.entre(30, 60);
+    if (g.entre(0, 3) == 0) r.taille_engin_min = g.entre(10, 30) / 10.0f;
+    if (g.entre(0, 1)) r.marque = g.entre(1, 4);
+    if (g.entre(0, 2) == 0) r.modele = g.entre(1, 8);
+    if (g.entre(0, 3) == 0) r.boite = g.entre(1, 2);
+    if (g.entre(0, 3) == 0) r.essence = g.entre(1, 3);
+    if (g.entre(0, 7) == 0) r.categorie = g.entre(1, 2);
+    return r;
+}
+
+//Parcours de reference : premiere ligne au prix le plus bas
+int32_t reference(const Colonnes& c, const RequeteFiltre& r) {
+    int32_t meilleure = -1;
+    for (size_t l = 0; l < c.annees.size(); l++) {
+        bool convient = c.annees[l] >= r.annee_min && c.kilometres[l] <= r.kilometres_max
+            && c.mpgs[l] >= r.mpg_min && c.tailles_engin[l] >= r.taille_engin_min
+            && (r.marque == TableChaines::VIDE || c.marques[l] == r.marque)
+            && (r.modele == TableChaines::VIDE || c.modeles[l] == r.modele)
+            && (r.boite == TableChaines::VIDE || c.boites[l] == r.boite)
+            && (r.essence == TableChaines::VIDE || c.essences[l] == r.essence)
+            && (r.categorie == TableChaines::VIDE || c.categories[l] == r.categorie);
+        if (convient && (meilleure < 0 || c.prix[l] < c.prix[meilleure])) {
+            meilleure = static_cast<int32_t>(l);
+        }
+    }
+    return meilleure;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <dossier data>" << endl;
+        return 2;
+    }
+    cout << "Jeu d'instructions: " << FiltreLot::getJeuInstructions() << endl;
+    FiltreLot::forcerScalaire(true);
+    VERIFIER(string(FiltreLot::getJeuInstructions()) == "scalaire");
+    FiltreLot::forcerScalaire(false);
+
+    //Colonnes synthetiques : AVX2, boucle simple et reference
+    GenerateurAleatoire g(12);
+    vector<size_t> tailles;
+    for (size_t n = 0; n <= 33; n++) {
+        tailles.push_back(n);
+    }
+    tailles.push_back(1000);
+    tailles.push_back(4099);
+    for (size_t n : tailles) {
+        Colonnes c = inventaire(g, n);
+        vector<RequeteFiltre> requetes;
+        for (int i = 0; i < 64; i++) {
+            requetes.push_back(requete(g));
+        }
+        vector<int32_t> simd, scalaire;
+        FiltreLot::moinsChers(c.vue(), requetes, simd);
+        FiltreLot::forcerScalaire(true);
+        FiltreLot::moinsChers(c.vue(), requetes, scalaire);
+        FiltreLot::forcerScalaire(false);
+        VERIFIER(simd == scalaire);
+        bool comme_reference = simd.size() == requetes.size();
+        for (size_t i = 0; comme_reference && i < requetes.size(); i++) {
+            comme_reference = simd[i] == reference(c, requetes[i]);
+        }
+        if (!comme_reference) {
+            cerr << "inventaire de " << n << " lignes" << endl;
+        }
+        VERIFIER(comme_reference);
+    }
+
+    //Vendeur du catalogue : le lot donne le prix de la recherche une a une
+    string dossier = copierDonnees(argv[1], "test_filtre_lot");
+    VERIFIER(Catalogue::getInstance().charger(dossier));
+    const CatalogueColonnes& colonnes = Catalogue::getInstance().getColonnes();
+    Vendeur vendeur(0, 1);
+    for (int i = 0; i < 2000 && colonnes.getNbrLignes() > 0; i++) {
+        vendeur.addVoitureCatalogue(Produit::nouvelIdentifiant(), g.entre(0, colonnes.getNbrLignes() - 1));
+    }
+    const char* marques[] = {"", "Audi", "BMW", "Ford", "VW", "Toyota"};
+    vector<shared_ptr<Voiture>> criteres;
+    vector<const Produit*> recherches;
+    for (int i = 0; i < 200 && !vendeur.getProduits().empty(); i++) {
+        const Voiture* modele = commeVoiture(vendeur.getProduits()[g.entre(0, vendeur.getProduits().size() - 1)].get());
+        shared_ptr<Voiture> q = make_shared<Voiture>();
+        if (i % 2) {
+            q->setBrand(modele->getBrand());
+            q->setModel(modele->getModel());
+        } else {
+            q->setBrand(marques[g.entre(0, 5)]);
+        }
+        if (g.entre(0, 1)) q->setYear(g.entre(2005, 2020));
+        if (g.entre(0, 1)) q->setKilometres(g.entre(1000, 80000));
+        if (g.entre(0, 3) == 0) q->setMPG(g.entre(30, 70));
+        if (g.entre(0, 3) == 0) q->setTailleEngin(g.entre(10, 30) / 10.0f);
+        if (g.entre(0, 5) == 0) q->setEssence("Diesel");
+        if (i % 40 == 0) q->setId(modele->getId());
+        criteres.push_back(q);
+        recherches.push_back(q.get());
+    }
+    for (bool scalaire : {false, true}) {
+        FiltreLot::forcerScalaire(scalaire);
+        vector<shared_ptr<Produit>> lot = vendeur.chercherProduits(recherches);
+        VERIFIER(lot.size() == recherches.size());
+        int differences = 0;
+        for (size_t i = 0; i < recherches.size() && i < lot.size(); i++) {
+            shared_ptr<Produit> un = vendeur.chercherProduit(recherches[i]);
+            if ((un == nullptr) != (lot[i] == nullptr) || (un != nullptr && un->getPrix() != lot[i]->getPrix())) {
+                differences++;
+            }
+        }
+        VERIFIER(differences == 0);
+    }
+    FiltreLot::forcerScalaire(false);
+
+    vendeur.libererProduits();
+    filesystem::remove_all(dossier);
+    return resultat("TestFiltreLot");
+}
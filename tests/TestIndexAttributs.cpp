@@ -0,0 +1,146 @@
+/**
+ * @file TestIndexAttributs.cpp
+ * @brief Recherches par intervalles d'IndexAttributs comparées à un parcours de toutes les voitures.
+ *
+ * Des voitures tirées au hasard, avec peu de valeurs distinctes pour que les bornes et les prix tombent souvent
+ * à égalité, sont indexées puis retirées par vagues, avec des prix qui changent entre-temps. Après chaque vague,
+ * moinsCher et moinsChersLot doivent rendre, pour chaque recherche, la voiture du parcours de référence : la
+ * moins chère parmi les voitures restantes, la première ajoutée à prix égal.
+ */
+
+#include <vector>
+#include "Verification.h"
+#include "IndexAttributs.h"
+#include "GenerateurAleatoire.h"
+#include "Voiture.h"
+
+using namespace std;
+
+namespace {
+
+const char* marques[] = {"Audi", "BMW", "Ford"};
+const char* modeles[] = {"A", "B", "C", "D"};
+const char* boites[] = {"Manual", "Automatic"};
+const char* essences[] = {"Petrol", "Diesel", "Hybrid"};
+
+shared_ptr<Voiture> voiture(GenerateurAleatoire& g, int id) {
+    return make_shared<Voiture>(id, "", g.entre(10, 20) * 1000.0f, g.entre(0, 9) ? "Voiture" : "Utilitaire", "",
+                                marques[g.entre(0, 2)], modeles[g.entre(0, 3)], g.entre(2010, 2020),
+                                boites[g.entre(0, 1)], g.entre(0, 10) * 10000, essences[g.entre(0, 2)],
+                                g.entre(30, 60), g.entre(10, 30) / 10.0f);
+}
+
+//Critere partiellement renseigne : les champs vides ou nuls signifient "peu importe"
+shared_ptr<Voiture> critere(GenerateurAleatoire& g) {
+    shared_ptr<Voiture> c = make_shared<Voiture>();
+    if (g.entre(0, 1)) c->setBrand(marques[g.entre(0, 2)]);
+    if (g.entre(0, 3) == 0) c->setModel(modeles[g.entre(0, 3)]);
+    if (g.entre(0, 1)) c->setYear(g.entre(2010, 2020));
+    if (g.entre(0, 1)) c->setKilometres(g.entre(1, 10) * 10000);
+    if (g.entre(0, 3) == 0) c->setMPG(g.entre(30, 60));
+    if (g.entre(0, 3) == 0) c->setTailleEngin(g.entre(10, 30) / 10.0f);
+    if (g.entre(0, 3) == 0) c->setBoiteDeVitesse(boites[g.entre(0, 1)]);
+    if (g.entre(0, 3) == 0) c->setEssence(essences[g.entre(0, 2)]);
+    if (g.entre(0, 5) == 0) c->setCategorie(g.entre(0, 1) ? "Voiture" : "Utilitaire");
+    return c;
+}
+
+bool convient(const Voiture& v, const Voiture& c) {
+    return (c.getBrand().empty() || v.getBrand() == c.getBrand())
+        && (c.getModel().empty() || v.getModel() == c.getModel())
+        && v.getYear() >= c.getYear()
+        && (c.getKilometres() == 0 || v.getKilometres() <= c.getKilometres())
+        && (c.getMPG() == 0 || v.getMPG() >= c.getMPG())
+        && (c.getTailleEngin() == 0 || v.getTailleEngin() >= c.getTailleEngin())
+        && (c.getBoiteDeVitesse().empty() || v.getBoiteDeVitesse() == c.getBoiteDeVitesse())
+        && (c.getEssence().empty() || v.getEssence() == c.getEssence())
+        && (c.getCategorie().empty() || v.getCategorie() == c.getCategorie());
+}
+
+//Parcours de reference, les voitures restantes dans l'ordre d'ajout
+shared_ptr<Produit> reference(const vector<shared_ptr<Voiture>>& restantes, const Voiture& c) {
+    shared_ptr<Produit> meilleure = nullptr;
+    for (const shared_ptr<Voiture>& v : restantes) {
+        if (convient(*v, c) && (meilleure == nullptr || v->getPrix() < meilleure->getPrix())) {
+            meilleure = v;
+        }
+    }
+    return meilleure;
+}
+
+}
+
+int main() {
+    GenerateurAleatoire g(11);
+    IndexAttributs index;
+    vector<shared_ptr<Voiture>> restantes;
+    for (int i = 0; i < 3000; i++) {
+        restantes.push_back(voiture(g, i));
+        index.ajouter(restantes.back());
+    }
+
+    vector<shared_ptr<Voiture>> criteres;
+    vector<const Voiture*> lot;
+    for (int i = 0; i < 300; i++) {
+        criteres.push_back(critere(g));
+        lot.push_back(criteres.back().get());
+    }
+
+    //Vagues de retraits : quelques lignes mortes, puis assez pour compacter l'index
+    shared_ptr<Voiture> retiree = nullptr;
+    for (int vague = 0; vague < 8; vague++) {
+        VERIFIER(index.getTaille() == restantes.size());
+        int un_a_un = 0;
+        int par_lot = 0;
+        vector<shared_ptr<Produit>> resultats;
+        index.moinsChersLot(lot, resultats);
+        VERIFIER(resultats.size() == lot.size());
+        for (size_t i = 0; i < lot.size() && i < resultats.size(); i++) {
+            shared_ptr<Produit> attendu = reference(restantes, *lot[i]);
+            un_a_un += index.moinsCher(*lot[i]) != attendu;
+            par_lot += resultats[i] != attendu;
+        }
+        if (un_a_un + par_lot > 0) {
+            cerr << "vague " << vague << ": " << un_a_un << " ecart(s) un a un, " << par_lot << " par lot" << endl;
+        }
+        VERIFIER(un_a_un == 0);
+        VERIFIER(par_lot == 0);
+
+        //Vente des voitures les moins cheres de quelques recherches, puis d'autres au hasard
+        for (int i = 0; i < 10 && !restantes.empty(); i++) {
+            shared_ptr<Produit> vendue = index.moinsCher(*lot[g.entre(0, lot.size() - 1)]);
+            if (vendue != nullptr) {
+                index.retirer(vendue.get());
+                erase(restantes, static_pointer_cast<Voiture>(vendue));
+            }
+        }
+        int nbr_retraits = vague % 2 ? 400 : 20;
+        for (int i = 0; i < nbr_retraits && !restantes.empty(); i++) {
+            size_t r = g.entre(0, restantes.size() - 1);
+            retiree = restantes[r];
+            index.retirer(retiree.get());
+            restantes.erase(restantes.begin() + r);
+        }
+        //Retirer deux fois la meme voiture ne change rien
+        if (retiree != nullptr) {
+            index.retirer(retiree.get());
+        }
+
+        //Les prix ne sont pas indexes
+        for (int i = 0; i < 100 && !restantes.empty(); i++) {
+            restantes[g.entre(0, restantes.size() - 1)]->setPrix(g.entre(10, 20) * 1000.0f);
+        }
+        if (vague == 5) {
+            for (int i = 0; i < 200; i++) {
+                restantes.push_back(voiture(g, 10000 + i));
+                index.ajouter(restantes.back());
+            }
+        }
+    }
+
+    index.vider();
+    VERIFIER(index.getTaille() == 0);
+    VERIFIER(index.moinsCher(*lot[0]) == nullptr);
+
+    return resultat("TestIndexAttributs");
+}
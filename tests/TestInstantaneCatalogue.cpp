@@ -0,0 +1,135 @@
+/**
+ * @file TestInstantaneCatalogue.cpp
+ * @brief Aller-retour de l'instantané binaire du catalogue, et rejet d'un instantané périmé.
+ *
+ * Le catalogue est chargé depuis une copie des CSV : le premier chargement décode le texte et écrit l'instantané,
+ * qui est relu et comparé colonne par colonne. L'instantané doit ensuite être rejeté si sa version, son contenu
+ * ou la taille d'une source change, et accepté (à réécrire) si seule une date change.
+ */
+
+#include <fstream>
+#include <chrono>
+#include "Verification.h"
+#include "Catalogue.h"
+#include "CatalogueColonnes.h"
+#include "InstantaneCatalogue.h"
+
+using namespace std;
+
+namespace {
+
+//Etat des sources tel que Catalogue::chargerColonnes le construit
+vector<EtatSource> etatSources(const Catalogue& catalogue) {
+    vector<EtatSource> sources(catalogue.getNbrMarques());
+    for (int i = 0; i < catalogue.getNbrMarques(); i++) {
+        string_view contenu = catalogue.getContenu(i);
+        sources[i].taille = contenu.size();
+        sources[i].donnees = contenu.data();
+        error_code erreur;
+        auto date = filesystem::last_write_time(catalogue.getChemin(i), erreur);
+        if (!erreur) {
+            sources[i].date_modif = chrono::duration_cast<chrono::nanoseconds>(date.time_since_epoch()).count();
+        }
+    }
+    return sources;
+}
+
+bool memeDictionnaire(const Dictionnaire& a, const Dictionnaire& b) {
+    if (a.getTaille() != b.getTaille()) {
+        return false;
+    }
+    for (size_t code = 0; code < a.getTaille(); code++) {
+        if (a.decoder(code) != b.decoder(code)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool memesColonnes(const CatalogueColonnes& a, const CatalogueColonnes& b) {
+    bool ok = a.getNbrLignes() == b.getNbrLignes() && a.getNbrMarques() == b.getNbrMarques();
+    for (int cat = 0; ok && cat < a.getNbrMarques(); cat++) {
+        ok = a.getDebutMarque(cat) == b.getDebutMarque(cat) && a.getNbrLignesMarque(cat) == b.getNbrLignesMarque(cat);
+    }
+    return ok
+        && a.getAnnees() == b.getAnnees() && a.getPrix() == b.getPrix()
+        && a.getKilometres() == b.getKilometres() && a.getTaxes() == b.getTaxes()
+        && a.getMPGs() == b.getMPGs() && a.getTaillesEngin() == b.getTaillesEngin()
+        && a.getMarques() == b.getMarques() && a.getModeles() == b.getModeles()
+        && a.getBoites() == b.getBoites() && a.getEssences() == b.getEssences()
+        && memeDictionnaire(a.getDicoMarques(), b.getDicoMarques())
+        && memeDictionnaire(a.getDicoModeles(), b.getDicoModeles())
+        && memeDictionnaire(a.getDicoBoites(), b.getDicoBoites())
+        && memeDictionnaire(a.getDicoEssences(), b.getDicoEssences());
+}
+
+//Reecrit 4 octets de l'instantane a la position donnee
+void ecraser(const string& chemin, streamoff position, uint32_t valeur) {
+    fstream fichier(chemin, ios::in | ios::out | ios::binary);
+    fichier.seekp(position);
+    fichier.write(reinterpret_cast<const char*>(&valeur), sizeof(valeur));
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <dossier data>" << endl;
+        return 2;
+    }
+    string dossier = copierDonnees(argv[1], "test_instantane");
+    string chemin = dossier + InstantaneCatalogue::NOM_FICHIER;
+
+    Catalogue& catalogue = Catalogue::getInstance();
+    VERIFIER(catalogue.charger(dossier));
+    VERIFIER(!catalogue.estDepuisInstantane());
+    VERIFIER(filesystem::exists(chemin));
+    const CatalogueColonnes& decodees = catalogue.getColonnes();
+    VERIFIER(decodees.getNbrLignes() > 0);
+
+    //Aller-retour : l'instantane ecrit au chargement redonne exactement les colonnes decodees
+    vector<EtatSource> sources = etatSources(catalogue);
+    CatalogueColonnes relues;
+    bool dates_changees = true;
+    VERIFIER(InstantaneCatalogue::lire(chemin, relues, sources, dates_changees));
+    VERIFIER(!dates_changees);
+    VERIFIER(memesColonnes(decodees, relues));
+
+    //Reecriture puis relecture : meme resultat
+    string copie = dossier + "copie.bin";
+    VERIFIER(InstantaneCatalogue::ecrire(copie, relues, sources));
+    CatalogueColonnes relues2;
+    VERIFIER(InstantaneCatalogue::lire(copie, relues2, sources, dates_changees));
+    VERIFIER(memesColonnes(decodees, relues2));
+
+    //Seule la date d'une source change : contenu identique, instantane accepte mais a reecrire
+    vector<EtatSource> dates = etatSources(catalogue);
+    dates[0].date_modif++;
+    CatalogueColonnes apres_date;
+    VERIFIER(InstantaneCatalogue::lire(chemin, apres_date, dates, dates_changees));
+    VERIFIER(dates_changees);
+    VERIFIER(memesColonnes(decodees, apres_date));
+
+    //Une source change de taille : instantane rejete
+    vector<EtatSource> tailles = etatSources(catalogue);
+    tailles.back().taille++;
+    CatalogueColonnes rejetees;
+    VERIFIER(!InstantaneCatalogue::lire(chemin, rejetees, tailles, dates_changees));
+
+    //Une source de plus ou de moins : rejete
+    vector<EtatSource> moins = etatSources(catalogue);
+    moins.pop_back();
+    VERIFIER(!InstantaneCatalogue::lire(chemin, rejetees, moins, dates_changees));
+
+    //Version differente (juste apres la magie de 8 octets) : rejete
+    ecraser(copie, 8, InstantaneCatalogue::VERSION + 1);
+    VERIFIER(!InstantaneCatalogue::lire(copie, rejetees, sources, dates_changees));
+
+    //Contenu corrompu : la somme de controle ne correspond plus
+    VERIFIER(InstantaneCatalogue::ecrire(copie, relues, sources));
+    ecraser(copie, filesystem::file_size(copie) - sizeof(uint32_t), 0xDEADBEEF);
+    VERIFIER(!InstantaneCatalogue::lire(copie, rejetees, sources, dates_changees));
+
+    filesystem::remove_all(dossier);
+    return resultat("TestInstantaneCatalogue");
+}
@@ -0,0 +1,121 @@
+/**
+ * @file TestInventaireVendeur.cpp
+ * @brief Retrait et réutilisation des emplacements de l'inventaire d'un vendeur (slot map).
+ *
+ * Après chaque retrait, la clé retirée doit être périmée, les autres clés valides, et les colonnes denses
+ * (produits, lignes) rester alignées. Une suite aléatoire d'ajouts et de retraits est comparée à un modèle simple.
+ */
+
+#include <vector>
+#include <map>
+#include "Verification.h"
+#include "InventaireVendeur.h"
+#include "GenerateurAleatoire.h"
+#include "Voiture.h"
+
+using namespace std;
+
+namespace {
+
+bool memeCle(InventaireVendeur::Cle a, InventaireVendeur::Cle b) {
+    return a.indice == b.indice && a.generation == b.generation;
+}
+
+//Compare l'inventaire au modele : produit -> (cle, ligne)
+bool coherent(const InventaireVendeur& inv, const map<const Produit*, pair<InventaireVendeur::Cle, int>>& modele) {
+    if (inv.getTaille() != modele.size() || inv.getProduits().size() != inv.getLignes().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < inv.getTaille(); i++) {
+        auto it = modele.find(inv.getProduits()[i].get());
+        if (it == modele.end() || inv.getLignes()[i] != it->second.second) {
+            return false;
+        }
+    }
+    for (const auto& [produit, etat] : modele) {
+        if (inv.obtenir(etat.first).get() != produit || !memeCle(inv.getCle(produit), etat.first)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main() {
+    InventaireVendeur inv;
+    vector<shared_ptr<Produit>> produits;
+    for (int i = 0; i < 4; i++) {
+        produits.push_back(make_shared<Voiture>());
+    }
+
+    InventaireVendeur::Cle a = inv.ajouter(produits[0], 10);
+    InventaireVendeur::Cle b = inv.ajouter(produits[1], 11);
+    InventaireVendeur::Cle c = inv.ajouter(produits[2], -1);
+    VERIFIER(inv.getTaille() == 3);
+    VERIFIER(a.generation != 0 && b.generation != 0 && c.generation != 0);
+    VERIFIER(inv.obtenir(b) == produits[1]);
+
+    //Retrait au milieu : le dernier produit prend sa place, sa cle reste valide
+    VERIFIER(inv.retirer(b));
+    VERIFIER(inv.getTaille() == 2);
+    VERIFIER(inv.obtenir(b) == nullptr);
+    VERIFIER(inv.getCle(produits[1].get()).generation == 0);
+    VERIFIER(inv.obtenir(c) == produits[2]);
+    VERIFIER(inv.getProduits()[1] == produits[2] && inv.getLignes()[1] == -1);
+    VERIFIER(!inv.retirer(b));
+    VERIFIER(!inv.retirer(produits[1].get()));
+
+    //Reutilisation de l'emplacement : nouvelle generation, l'ancienne cle ne designe pas le nouveau produit
+    InventaireVendeur::Cle d = inv.ajouter(produits[3], 13);
+    VERIFIER(d.indice == b.indice);
+    VERIFIER(d.generation != b.generation);
+    VERIFIER(inv.obtenir(b) == nullptr);
+    VERIFIER(inv.obtenir(d) == produits[3]);
+    VERIFIER(!inv.retirer(b));
+    VERIFIER(inv.getTaille() == 3);
+
+    //Retrait par produit, puis du dernier
+    VERIFIER(inv.retirer(produits[0].get()));
+    VERIFIER(inv.obtenir(a) == nullptr);
+    VERIFIER(inv.retirer(d));
+    VERIFIER(inv.retirer(c));
+    VERIFIER(inv.getTaille() == 0);
+    VERIFIER(inv.obtenir(c) == nullptr);
+
+    //Suite aleatoire d'ajouts et de retraits, comparee au modele
+    InventaireVendeur aleatoire;
+    map<const Produit*, pair<InventaireVendeur::Cle, int>> modele;
+    vector<InventaireVendeur::Cle> perimees;
+    vector<shared_ptr<Produit>> gardes;
+    GenerateurAleatoire g(16);
+    bool toujours_coherent = true;
+    bool perimees_refusees = true;
+    for (int etape = 0; etape < 5000; etape++) {
+        if (modele.empty() || g.entre(0, 2) > 0) {
+            shared_ptr<Produit> p = make_shared<Voiture>();
+            gardes.push_back(p);
+            int ligne = g.entre(-1, 1000);
+            modele[p.get()] = {aleatoire.ajouter(p, ligne), ligne};
+        } else {
+            const shared_ptr<Produit>& p = aleatoire.getProduits()[g.entre(0, aleatoire.getTaille() - 1)];
+            const Produit* brut = p.get();
+            InventaireVendeur::Cle cle = modele[brut].first;
+            bool retire = g.entre(0, 1) ? aleatoire.retirer(cle) : aleatoire.retirer(brut);
+            toujours_coherent = toujours_coherent && retire;
+            modele.erase(brut);
+            perimees.push_back(cle);
+        }
+        if (etape % 50 == 0) {
+            toujours_coherent = toujours_coherent && coherent(aleatoire, modele);
+        }
+    }
+    for (InventaireVendeur::Cle cle : perimees) {
+        perimees_refusees = perimees_refusees && aleatoire.obtenir(cle) == nullptr && !aleatoire.retirer(cle);
+    }
+    VERIFIER(toujours_coherent);
+    VERIFIER(coherent(aleatoire, modele));
+    VERIFIER(perimees_refusees);
+
+    return resultat("TestInventaireVendeur");
+}
@@ -0,0 +1,102 @@
+/**
+ * @file TestTableProduits.cpp
+ * @brief Poignées de TableProduits : réutilisation d'un emplacement libéré et détection des poignées périmées.
+ */
+
+#include <vector>
+#include <thread>
+#include "Verification.h"
+#include "TableProduits.h"
+#include "Voiture.h"
+
+using namespace std;
+
+int main() {
+    TableProduits& table = TableProduits::getInstance();
+    size_t taille_initiale = table.getTaille();
+
+    //Enregistrement : le produit garde sa premiere poignee
+    shared_ptr<Voiture> v = make_shared<Voiture>();
+    PoigneeProduit a = table.enregistrer(v);
+    VERIFIER(!a.estNulle());
+    VERIFIER(table.obtenir(a) == v.get());
+    VERIFIER(v->getPoignee() == a);
+    PoigneeProduit b = table.enregistrer(v);
+    VERIFIER(b != a);
+    VERIFIER(table.obtenir(b) == v.get());
+    VERIFIER(v->getPoignee() == a);
+    VERIFIER(table.getTaille() == taille_initiale + 2);
+
+    //Liberation : l'ancienne poignee ne donne plus rien, l'autre reste valide
+    table.liberer(a);
+    VERIFIER(table.obtenir(a) == nullptr);
+    VERIFIER(table.partager(a) == nullptr);
+    VERIFIER(v->getPoignee().estNulle());
+    VERIFIER(table.obtenir(b) == v.get());
+
+    //Reutilisation : meme emplacement, nouvelle generation, l'ancienne poignee reste perimee
+    shared_ptr<Voiture> w = make_shared<Voiture>();
+    PoigneeProduit c = table.enregistrer(w);
+    VERIFIER(c.indice == a.indice);
+    VERIFIER(c.generation != a.generation);
+    VERIFIER(table.obtenir(a) == nullptr);
+    VERIFIER(table.obtenir(c) == w.get());
+
+    //Une poignee perimee ne libere pas le nouveau produit de l'emplacement
+    table.liberer(a);
+    VERIFIER(table.obtenir(c) == w.get());
+    VERIFIER(table.partager(c) == w);
+
+    //Poignee nulle
+    VERIFIER(table.obtenir(PoigneeProduit()) == nullptr);
+    VERIFIER(table.enregistrer(nullptr).estNulle());
+    table.liberer(PoigneeProduit());
+
+    table.liberer(b);
+    table.liberer(c);
+    VERIFIER(table.getTaille() == taille_initiale);
+
+    //Plus d'un bloc, enregistre, lu et libere par plusieurs threads en meme temps
+    const int nbr_threads = 4;
+    const int nbr_produits = 3000;
+    vector<vector<PoigneeProduit>> poignees(nbr_threads);
+    vector<thread> threads;
+    for (int t = 0; t < nbr_threads; t++) {
+        threads.emplace_back([&table, &poignees, t]() {
+            for (int i = 0; i < nbr_produits; i++) {
+                shared_ptr<Voiture> p = make_shared<Voiture>();
+                PoigneeProduit h = table.enregistrer(p);
+                if (table.obtenir(h) != p.get()) {
+                    return;
+                }
+                poignees[t].push_back(h);
+                if (i % 3 == 0) {
+                    table.liberer(h);
+                }
+            }
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    size_t vivants = 0;
+    bool valides = true;
+    for (int t = 0; t < nbr_threads; t++) {
+        VERIFIER(poignees[t].size() == static_cast<size_t>(nbr_produits));
+        for (size_t i = 0; i < poignees[t].size(); i++) {
+            bool libere = i % 3 == 0;
+            valides = valides && (table.obtenir(poignees[t][i]) == nullptr) == libere;
+            vivants += libere ? 0 : 1;
+        }
+    }
+    VERIFIER(valides);
+    VERIFIER(table.getTaille() == taille_initiale + vivants);
+    for (const auto& liste : poignees) {
+        for (PoigneeProduit h : liste) {
+            table.liberer(h);
+        }
+    }
+    VERIFIER(table.getTaille() == taille_initiale);
+
+    return resultat("TestTableProduits");
+}
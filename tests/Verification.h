@@ -0,0 +1,46 @@
+#ifndef VERIFICATION_H
+#define VERIFICATION_H
+
+#include <iostream>
+#include <string>
+#include <filesystem>
+#include <unistd.h>
+
+using namespace std;
+
+//Outils communs aux tests : chaque test est un executable qui retourne le nombre d'echecs
+
+inline int echecs = 0;
+
+#define VERIFIER(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << __FILE__ << ":" << __LINE__ << ": echec: " << #condition << endl; \
+            echecs++; \
+        } \
+    } while (0)
+
+//Copie les fichiers CSV du dossier data dans un dossier temporaire propre au test, termine par '/'
+//Le catalogue y ecrit son instantane sans toucher a celui du depot
+inline string copierDonnees(const string& source, const string& nom_test) {
+    filesystem::path dossier = filesystem::temp_directory_path() / (nom_test + "_" + to_string(getpid()));
+    filesystem::remove_all(dossier);
+    filesystem::create_directories(dossier);
+    for (const auto& entree : filesystem::directory_iterator(source)) {
+        if (entree.path().extension() == ".csv") {
+            filesystem::copy_file(entree.path(), dossier / entree.path().filename());
+        }
+    }
+    return dossier.string() + "/";
+}
+
+inline int resultat(const string& nom_test) {
+    if (echecs == 0) {
+        cout << nom_test << ": ok" << endl;
+    } else {
+        cerr << nom_test << ": " << echecs << " echec(s)" << endl;
+    }
+    return echecs == 0 ? 0 : 1;
+}
+
+#endif